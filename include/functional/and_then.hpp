@@ -16,6 +16,7 @@
 #include "functional/utility.hpp"
 
 #include <concepts>
+#include <type_traits>
 #include <utility>
 
 namespace fn {
@@ -46,6 +47,7 @@ constexpr inline struct and_then_t final {
   }
 
   struct apply;
+  struct fuse;
 } and_then = {};
 
 struct and_then_t::apply final {
@@ -57,6 +59,24 @@ struct and_then_t::apply final {
   }
 };
 
+// NOTE Stage of a fused `pipeline`
+struct and_then_t::fuse final {
+  [[nodiscard]] static constexpr auto operator()(auto &&next, auto &&v, auto &&fn) noexcept -> decltype(auto)
+  {
+    auto result = next.call(FWD(fn), FWD(v));
+    if (not result.has_value()) {
+      if constexpr (some_expected<decltype(result)>)
+        return next.fail(std::move(result).error());
+      else
+        return next.fail();
+    }
+    if constexpr (std::is_void_v<typename decltype(result)::value_type>)
+      return next();
+    else
+      return next(*std::move(result));
+  }
+};
+
 } // namespace fn
 
 #endif // INCLUDE_FUNCTIONAL_AND_THEN
@@ -0,0 +1,297 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_BINARY
+#define INCLUDE_FUNCTIONAL_BINARY
+
+#include "functional/choice.hpp"
+#include "functional/detail/functional.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/functional.hpp"
+#include "functional/fwd.hpp"
+#include "functional/pack.hpp"
+#include "functional/sum.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fn {
+
+namespace detail {
+[[nodiscard]] constexpr auto _round_up(std::size_t v, std::size_t a) noexcept -> std::size_t
+{
+  return (v + a - 1) / a * a;
+}
+
+template <typename T> [[nodiscard]] constexpr auto _binary_load(std::byte const *in) noexcept -> T
+{
+  std::array<std::byte, sizeof(T)> buffer;
+  std::copy_n(in, sizeof(T), buffer.begin());
+  return std::bit_cast<T>(buffer);
+}
+
+// NOTE Access an object of trivially copyable type directly in the encoded data, without copying it
+template <typename T> [[nodiscard]] auto _binary_object(std::byte const *in) noexcept -> T const &
+{
+#if defined(__cpp_lib_start_lifetime_as) && __cpp_lib_start_lifetime_as >= 202207L
+  return *std::start_lifetime_as<T>(in);
+#else
+  return *std::launder(reinterpret_cast<T const *>(in));
+#endif
+}
+} // namespace detail
+
+// NOTE Stored at the start of the encoded data. The type key is derived from `detail::type_sortkey_v` and hence does
+// not change between builds, as long as the names of the types and the compiler do not change. The magic number
+// also detects mismatched byte order of the platform.
+struct binary_header final {
+  static constexpr std::uint64_t magic_v = 0x006e69623a3a6e66ull; // "fn::bin"
+  static constexpr std::uint32_t version_v = 1;
+
+  std::uint64_t magic;
+  std::uint64_t type_key;
+  std::uint32_t version;
+  std::uint32_t record_size;
+
+  [[nodiscard]] constexpr bool operator==(binary_header const &) const noexcept = default;
+};
+
+template <typename T> struct binary_format; // Intentionally incomplete
+
+// NOTE Fixed size records, each starting with the discriminator followed by the payload, aligned for every alternative.
+// Bytes not taken by the discriminator or by the active alternative are zero.
+template <typename... Ts>
+  requires(... && std::is_trivially_copyable_v<Ts>)
+struct binary_format<sum<Ts...>> {
+  using value_type = sum<Ts...>;
+  using index_t = typename value_type::index_t;
+  using data_t = typename value_type::data_t;
+
+  static constexpr std::uint64_t type_key = detail::_fnv1a(detail::type_sortkey_v<value_type>);
+  static constexpr std::size_t alignment = std::max(alignof(data_t), alignof(index_t));
+  static constexpr std::size_t payload_offset = detail::_round_up(sizeof(index_t), alignof(data_t));
+  static constexpr std::size_t record_size = detail::_round_up(payload_offset + sizeof(data_t), alignment);
+  static constexpr std::size_t data_offset = detail::_round_up(sizeof(binary_header), alignment);
+
+  [[nodiscard]] static constexpr auto header() noexcept -> binary_header
+  {
+    return {binary_header::magic_v, type_key, binary_header::version_v, static_cast<std::uint32_t>(record_size)};
+  }
+
+  static void encode(value_type const &v, std::byte *out) noexcept
+  {
+    std::fill_n(out, record_size, std::byte{0});
+    index_t const index = v.index;
+    std::memcpy(out, &index, sizeof(index_t));
+    v.invoke([out](auto const &v) noexcept { std::memcpy(out + payload_offset, &v, sizeof(v)); });
+  }
+
+  [[nodiscard]] static auto index(std::byte const *in) noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(detail::_binary_load<index_t>(in));
+  }
+
+  [[nodiscard]] static auto valid(std::byte const *in) noexcept -> bool { return index(in) < value_type::size; }
+
+  // NOTE Precondition: valid(in)
+  [[nodiscard]] static auto decode(std::byte const *in) noexcept -> value_type
+  {
+    return value_type::from_index(index(in), {in + payload_offset, record_size - payload_offset});
+  }
+
+  template <typename Fn>
+  [[nodiscard]] static auto invoke(std::byte const *in, Fn &&fn) noexcept(
+      detail::_is_nothrow_select_invoke<detail::_invoke_autodetect_tag, Fn, value_type const &>)
+    requires typelist_invocable<Fn, value_type const &> && (not typelist_type_invocable<Fn, value_type const &>)
+  {
+    using type = detail::_typelist_select_invoke_result<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, false>(in, index(in), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] static auto invoke(std::byte const *in, Fn &&fn) noexcept(
+      detail::_is_nothrow_invoke_type<detail::_invoke_autodetect_tag, Fn, value_type const &>)
+    requires typelist_type_invocable<Fn, value_type const &>
+  {
+    using type = detail::_typelist_type_select_invoke_result<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, true>(in, index(in), FWD(fn));
+  }
+
+  template <typename R, bool Typed, std::size_t I = 0>
+  static auto _invoke_at(std::byte const *in, std::size_t index, auto &&fn) -> R
+  {
+    if constexpr (I + 1 < sizeof...(Ts)) {
+      if (index != I)
+        return _invoke_at<R, Typed, I + 1>(in, index, FWD(fn));
+    }
+    using T = typename value_type::template select_nth<I>;
+    T const &v = detail::_binary_object<T>(in + payload_offset);
+    if constexpr (Typed)
+      return static_cast<R>(detail::_invoke(FWD(fn), std::in_place_type<T>, v));
+    else
+      return static_cast<R>(detail::_invoke(FWD(fn), v));
+  }
+};
+
+// NOTE Same format and type key as `sum` of the same types, so the encoded data can be read as either
+template <typename... Ts>
+  requires(... && std::is_trivially_copyable_v<Ts>)
+struct binary_format<choice<Ts...>> : binary_format<sum<Ts...>> {
+  using value_type = choice<Ts...>;
+  using _impl = binary_format<sum<Ts...>>;
+
+  static void encode(value_type const &v, std::byte *out) noexcept { _impl::encode(v.value(), out); }
+
+  // NOTE Precondition: valid(in)
+  [[nodiscard]] static auto decode(std::byte const *in) noexcept -> value_type
+  {
+    constexpr std::size_t offset = _impl::payload_offset;
+    return value_type::from_index(_impl::index(in), {in + offset, _impl::record_size - offset});
+  }
+};
+
+// NOTE Fixed size records with elements laid out in order, each aligned for its type, with zeroed padding
+template <typename... Ts>
+  requires(sizeof...(Ts) > 0)
+          && (... && (std::is_trivially_copyable_v<Ts> && std::is_same_v<Ts, std::remove_cvref_t<Ts>>))
+struct binary_format<pack<Ts...>> {
+  using value_type = pack<Ts...>;
+
+  static constexpr std::uint64_t type_key = detail::_fnv1a(detail::type_sortkey_v<value_type>);
+  static constexpr std::size_t alignment = std::max({alignof(Ts)...});
+  static constexpr std::array<std::size_t, sizeof...(Ts)> offsets = [] {
+    std::array<std::size_t, sizeof...(Ts)> result = {};
+    std::size_t offset = 0;
+    std::size_t i = 0;
+    (..., (offset = detail::_round_up(offset, alignof(Ts)), result[i++] = offset, offset += sizeof(Ts)));
+    return result;
+  }();
+  static constexpr std::size_t record_size
+      = detail::_round_up(offsets.back() + sizeof(detail::select_nth_t<sizeof...(Ts) - 1, Ts...>), alignment);
+  static constexpr std::size_t data_offset = detail::_round_up(sizeof(binary_header), alignment);
+
+  [[nodiscard]] static constexpr auto header() noexcept -> binary_header
+  {
+    return {binary_header::magic_v, type_key, binary_header::version_v, static_cast<std::uint32_t>(record_size)};
+  }
+
+  static void encode(value_type const &v, std::byte *out) noexcept
+  {
+    std::fill_n(out, record_size, std::byte{0});
+    v.invoke([out](auto const &...v) noexcept {
+      std::size_t i = 0;
+      (..., std::memcpy(out + offsets[i++], &v, sizeof(v)));
+    });
+  }
+
+  [[nodiscard]] static auto valid(std::byte const *) noexcept -> bool { return true; }
+
+  [[nodiscard]] static auto decode(std::byte const *in) noexcept -> value_type
+  {
+    return [in]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return value_type{detail::_binary_load<Ts>(in + offsets[Is])...};
+    }(std::index_sequence_for<Ts...>{});
+  }
+
+  template <typename Fn>
+  [[nodiscard]] static auto invoke(std::byte const *in, Fn &&fn) noexcept(
+      detail::_is_nothrow_invocable_v<Fn, Ts const &...>) -> decltype(auto)
+    requires std::is_invocable_v<Fn, Ts const &...>
+  {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto) {
+      return detail::_invoke(FWD(fn), detail::_binary_object<Ts>(in + offsets[Is])...);
+    }(std::index_sequence_for<Ts...>{});
+  }
+};
+
+// NOTE Encode values of a range into a new buffer, header first
+template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+  requires requires { binary_format<T>::record_size; }
+[[nodiscard]] auto binary_encode(R &&r) -> std::vector<std::byte>
+{
+  using format = binary_format<T>;
+  std::vector<std::byte> result(format::data_offset);
+  binary_header const header = format::header();
+  std::memcpy(result.data(), &header, sizeof(header));
+  for (auto const &v : r) {
+    std::size_t const offset = result.size();
+    result.resize(offset + format::record_size);
+    format::encode(v, result.data() + offset);
+  }
+  return result;
+}
+
+// NOTE Read-only view of data encoded by `binary_format`, e.g. in a memory-mapped file. Records are visited directly
+// in the encoded data, without copying them into `T`. The data must be aligned to `binary_format<T>::alignment`,
+// which is satisfied by both memory pages and default `operator new`, except for over-aligned types.
+template <typename T>
+  requires requires { binary_format<T>::record_size; }
+struct binary_view {
+  using format = binary_format<T>;
+  using value_type = T;
+  using size_type = std::size_t;
+
+  std::span<std::byte const> bytes;
+
+  // NOTE Checks the header, alignment and size of data, and that every record is valid. This is the precondition of
+  // all other member functions.
+  [[nodiscard]] auto valid() const noexcept -> bool
+  {
+    if (bytes.size() < format::data_offset
+        || reinterpret_cast<std::uintptr_t>(bytes.data()) % format::alignment != 0
+        || (bytes.size() - format::data_offset) % format::record_size != 0)
+      return false;
+    if (detail::_binary_load<binary_header>(bytes.data()) != format::header())
+      return false;
+    for (size_type i = 0; i < size(); ++i) {
+      if (not format::valid(_record(i)))
+        return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr auto size() const noexcept -> size_type
+  {
+    return (bytes.size() - format::data_offset) / format::record_size;
+  }
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size() == 0; }
+
+  [[nodiscard]] auto operator[](size_type i) const noexcept -> value_type { return format::decode(_record(i)); }
+
+  [[nodiscard]] auto index(size_type i) const noexcept -> std::size_t
+    requires requires(std::byte const *in) { format::index(in); }
+  {
+    return format::index(_record(i));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] auto invoke(size_type i, Fn &&fn) const noexcept(noexcept(format::invoke(_record(i), FWD(fn))))
+      -> decltype(auto)
+    requires requires(std::byte const *in) { format::invoke(in, FWD(fn)); }
+  {
+    return format::invoke(_record(i), FWD(fn));
+  }
+
+  [[nodiscard]] constexpr auto _record(size_type i) const noexcept -> std::byte const *
+  {
+    return bytes.data() + format::data_offset + i * format::record_size;
+  }
+};
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_BINARY
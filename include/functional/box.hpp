@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_BOX
+#define INCLUDE_FUNCTIONAL_BOX
+
+#include "functional/detail/functional.hpp"
+#include "functional/detail/fwd.hpp"
+#include "functional/detail/traits.hpp"
+#include "functional/fwd.hpp"
+
+#include <compare>
+#include <concepts>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace fn {
+
+template <typename T>
+concept some_box = detail::_some_box<T>;
+
+// NOTE Owning pointer with value semantics, for recursive (or otherwise incomplete) alternatives of `sum` and
+// `choice`, e.g. `struct List; using Json = choice<double, std::string, box<List>>;`. Functions invoked on `sum` or
+// `choice` with `invoke`, `invoke_r`, `transform` etc. see the boxed `T` rather than the box itself; `invoke_with`
+// and other dispatch over several sums at once do not.
+//
+// The value is allocated from a `std::pmr::memory_resource`, which is the default resource unless passed explicitly
+// with `std::allocator_arg`. Unlike `std::pmr` containers, a copy is allocated from the same resource as the original,
+// so that copying a node of a tree built in an arena such as `std::pmr::monotonic_buffer_resource` keeps the copy in
+// that arena; use `std::allocator_arg` to copy into a different resource. Assignment does not change the resource of
+// the target. The memory of the whole tree is released at once by the arena, and the teardown of a tree only runs
+// the destructors of its nodes.
+//
+// Unlike `std::unique_ptr` a box is never empty, unless moved-from. Only the destructor and assignment are
+// allowed on a moved-from box.
+template <typename T> struct box final {
+  static_assert(std::is_object_v<T> && (not std::is_const_v<T>) && (not std::is_array_v<T>));
+
+  using value_type = T;
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  struct _node final {
+    std::pmr::memory_resource *resource;
+    T value;
+
+    constexpr _node(std::pmr::memory_resource *r, auto &&...args) : resource(r), value(FWD(args)...) {}
+  };
+
+  explicit box(T const &v) : _ptr(_make(allocator_type{}, v)) {}
+  explicit box(T &&v) : _ptr(_make(allocator_type{}, std::move(v))) {}
+
+  template <typename... Args>
+  explicit box(std::in_place_t, Args &&...args)
+    requires std::is_constructible_v<T, Args...>
+      : _ptr(_make(allocator_type{}, FWD(args)...))
+  {
+  }
+
+  template <typename... Args>
+  box(std::allocator_arg_t, allocator_type const &alloc, Args &&...args)
+    requires std::is_constructible_v<T, Args...>
+      : _ptr(_make(alloc, FWD(args)...))
+  {
+  }
+
+  box(box const &other) : _ptr(other._ptr ? _make(other.get_allocator(), other._ptr->value) : nullptr) {}
+  box(box &&other) noexcept : _ptr(std::exchange(other._ptr, nullptr)) {}
+  ~box() noexcept { _free(_ptr); }
+
+  // NOTE The copy is allocated from the resource of this box, unless moved-from. The old value is freed last, since
+  // `other` might be owned by it
+  box &operator=(box const &other)
+  {
+    if (this == &other)
+      return *this;
+    if (_ptr == nullptr)
+      return *this = box(other);
+    _free(std::exchange(_ptr, other._ptr ? _make(get_allocator(), other._ptr->value) : nullptr));
+    return *this;
+  }
+
+  // NOTE The old value is freed last, since `other` might be owned by it
+  box &operator=(box &&other) noexcept
+  {
+    _free(std::exchange(_ptr, std::exchange(other._ptr, nullptr)));
+    return *this;
+  }
+
+  [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return allocator_type{_ptr->resource}; }
+
+  [[nodiscard]] constexpr T *get() noexcept { return std::addressof(_ptr->value); }
+  [[nodiscard]] constexpr T const *get() const noexcept { return std::addressof(_ptr->value); }
+  [[nodiscard]] constexpr T *operator->() noexcept { return std::addressof(_ptr->value); }
+  [[nodiscard]] constexpr T const *operator->() const noexcept { return std::addressof(_ptr->value); }
+
+  [[nodiscard]] constexpr T &operator*() & noexcept { return _ptr->value; }
+  [[nodiscard]] constexpr T const &operator*() const & noexcept { return _ptr->value; }
+  [[nodiscard]] constexpr T &&operator*() && noexcept { return std::move(_ptr->value); }
+  [[nodiscard]] constexpr T const &&operator*() const && noexcept { return std::move(_ptr->value); }
+
+  [[nodiscard]] static auto _make(allocator_type alloc, auto &&...args) -> _node *
+  {
+    return alloc.template new_object<_node>(alloc.resource(), FWD(args)...);
+  }
+
+  static void _free(_node *ptr) noexcept
+  {
+    if (ptr != nullptr)
+      allocator_type{ptr->resource}.delete_object(ptr);
+  }
+
+private:
+  _node *_ptr;
+};
+
+template <typename T>
+[[nodiscard]] constexpr bool operator==(box<T> const &lh, box<T> const &rh) noexcept
+  requires std::equality_comparable<T>
+{
+  return *lh == *rh;
+}
+
+template <typename T>
+[[nodiscard]] constexpr auto operator<=>(box<T> const &lh, box<T> const &rh) noexcept
+    -> std::compare_three_way_result_t<T>
+  requires std::three_way_comparable<T>
+{
+  return *lh <=> *rh;
+}
+
+namespace detail {
+template <typename T> constexpr bool _is_box_type = false;
+template <typename T> constexpr bool _is_box_type<std::in_place_type_t<::fn::box<T>>> = true;
+
+// NOTE Pass the value held by a box (and the type tag of that value, rather than of the box) to the function
+template <typename V> [[nodiscard]] constexpr auto _unbox(V &&v) noexcept -> decltype(auto)
+{
+  using type = std::remove_cvref_t<V>;
+  if constexpr (_some_box<type>) {
+    return static_cast<apply_const_lvalue_t<V, typename type::value_type &&>>(*v);
+  } else if constexpr (_is_box_type<type>) {
+    return [&]<typename T>(std::in_place_type_t<::fn::box<T>>) { return std::in_place_type_t<T>{}; }(v);
+  } else {
+    return static_cast<V &&>(v);
+  }
+}
+
+template <typename V> using _unboxed_t = decltype(_unbox(std::declval<V>()));
+
+template <typename Fn> struct _unboxing_fn final {
+  Fn &&fn;
+
+  constexpr auto operator()(auto &&...args) const noexcept(_is_nothrow_invocable_v<Fn, _unboxed_t<decltype(args)>...>)
+      -> _invoke_result_t<Fn, _unboxed_t<decltype(args)>...>
+    requires _is_invocable_v<Fn, _unboxed_t<decltype(args)>...>
+  {
+    return _invoke(FWD(fn), _unbox(FWD(args))...);
+  }
+};
+
+template <typename... Ts> constexpr bool _has_box = (... || _some_box<Ts>);
+
+// NOTE Only wrap functions invoked on sums which do hold a box
+template <bool Unbox, typename Fn> [[nodiscard]] constexpr auto _unboxing(Fn &&fn) noexcept -> decltype(auto)
+{
+  if constexpr (Unbox) {
+    return _unboxing_fn<Fn>{FWD(fn)};
+  } else {
+    return FWD(fn);
+  }
+}
+} // namespace detail
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_BOX
@@ -10,6 +10,9 @@
 #include "functional/sum.hpp"
 #include "functional/utility.hpp"
 
+#include <compare>
+#include <cstddef>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -39,7 +42,7 @@ struct choice<Ts...> : sum<Ts...> {
   template <typename T> static constexpr bool has_type = _impl::template has_type<T>;
 
   template <typename T>
-  constexpr choice(T &&v)
+  constexpr choice(T &&v) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
     requires has_type<std::remove_cvref_t<T>> && (std::is_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
              && (std::is_convertible_v<decltype(v), std::remove_cvref_t<T>>)
       : _impl(std::in_place_type<std::remove_cvref_t<T>>, FWD(v))
@@ -47,7 +50,7 @@ struct choice<Ts...> : sum<Ts...> {
   }
 
   template <typename T>
-  constexpr explicit choice(T &&v)
+  constexpr explicit choice(T &&v) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
     requires has_type<std::remove_cvref_t<T>> && (std::is_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
              && (not std::is_convertible_v<decltype(v), std::remove_cvref_t<T>>)
       : _impl(std::in_place_type<std::remove_cvref_t<T>>, FWD(v))
@@ -55,37 +58,48 @@ struct choice<Ts...> : sum<Ts...> {
   }
 
   template <typename T>
-  constexpr choice(std::in_place_type_t<T> d, auto &&...args) noexcept
+  constexpr choice(std::in_place_type_t<T> d, auto &&...args) noexcept(
+      std::is_nothrow_constructible_v<T, decltype(args)...>)
     requires has_type<T>
       : _impl(d, FWD(args)...)
   {
   }
 
   template <typename... Tx>
-  constexpr choice(sum<Tx...> const &v) noexcept
+  constexpr choice(sum<Tx...> const &v) noexcept(detail::_all_nothrow_copy_constructible<Tx...>)
     requires detail::is_superset_of<choice, choice<Tx...>> && (... && std::is_copy_constructible_v<Tx>)
       : _impl(std::in_place_type<sum<Tx...>>, FWD(v))
   {
   }
 
   template <typename... Tx>
-  constexpr choice(sum<Tx...> &&v) noexcept
+  constexpr choice(sum<Tx...> &&v) noexcept(detail::_all_nothrow_move_constructible<Tx...>)
     requires detail::is_superset_of<choice, choice<Tx...>> && (... && std::is_move_constructible_v<Tx>)
       : _impl(std::in_place_type<sum<Tx...>>, FWD(v))
   {
   }
 
   template <typename... Tx>
-  constexpr choice(std::in_place_type_t<sum<Tx...>>, some_sum auto &&v) noexcept
+  constexpr choice(std::in_place_type_t<sum<Tx...>>, some_sum auto &&v) noexcept(
+      detail::_is_nothrow_sum_forward<decltype(v)>)
     requires std::is_same_v<std::remove_cvref_t<decltype(v)>, sum<Tx...>>
              && detail::is_superset_of<choice, choice<Tx...>>
       : _impl(std::in_place_type<sum<Tx...>>, FWD(v))
   {
   }
 
-  constexpr choice(choice const &other) noexcept = default;
-  constexpr choice(choice &&other) noexcept = default;
+  constexpr choice(choice const &other) = default;
+  constexpr choice(choice &&other) = default;
   constexpr ~choice() = default;
+  constexpr choice &operator=(choice const &other) = default;
+  constexpr choice &operator=(choice &&other) = default;
+
+  // NOTE See sum::from_index
+  [[nodiscard]] static constexpr auto from_index(std::size_t i, std::span<std::byte const> bytes) noexcept -> choice
+    requires(... && std::is_trivially_copyable_v<Ts>)
+  {
+    return choice{std::in_place_type<_impl>, _impl::from_index(i, bytes)};
+  }
 
   [[nodiscard]] constexpr value_type &value() & noexcept { return *this; }
   [[nodiscard]] constexpr value_type const &value() const & noexcept { return *this; }
@@ -93,155 +107,187 @@ struct choice<Ts...> : sum<Ts...> {
   [[nodiscard]] constexpr value_type const &&value() const && noexcept { return std::move(*this); }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) & noexcept(detail::_is_nothrow_select_invoke<T, Fn, choice &>)
     requires typelist_invocable<Fn, choice &> && (not typelist_type_invocable<Fn, choice &>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), choice &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) & noexcept(detail::_is_nothrow_invoke_type<T, Fn, choice &>)
     requires typelist_type_invocable<Fn, choice &>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), choice &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_select_invoke<T, Fn, choice const &>)
     requires typelist_invocable<Fn, choice const &> && (not typelist_type_invocable<Fn, choice const &>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), choice const &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_invoke_type<T, Fn, choice const &>)
     requires typelist_type_invocable<Fn, choice const &>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), choice const &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) && noexcept(detail::_is_nothrow_select_invoke<T, Fn, choice &&>)
     requires typelist_invocable<Fn, choice &&> && (not typelist_type_invocable<Fn, choice &&>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), choice &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) && noexcept(detail::_is_nothrow_invoke_type<T, Fn, choice &&>)
     requires typelist_type_invocable<Fn, choice &&>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), choice &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_select_invoke<T, Fn, choice const &&>)
     requires typelist_invocable<Fn, choice const &&> && (not typelist_type_invocable<Fn, choice const &&>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), choice const &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename T = detail::_invoke_autodetect_tag, typename Fn>
-  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform_to(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_invoke_type<T, Fn, choice const &&>)
     requires typelist_type_invocable<Fn, choice const &&>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), choice const &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   // NOTE Monadic operations, only `and_then` and `transform` are supported
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, choice &>)
     requires typelist_invocable<Fn, choice &> && (not typelist_type_invocable<Fn, choice &>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), choice &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, choice &>)
     requires typelist_type_invocable<Fn, choice &>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), choice &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, choice const &>)
     requires typelist_invocable<Fn, choice const &> && (not typelist_type_invocable<Fn, choice const &>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), choice const &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, choice const &>)
     requires typelist_type_invocable<Fn, choice const &>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), choice const &>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(_impl::data, _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, choice &&>)
     requires typelist_invocable<Fn, choice &&> && (not typelist_type_invocable<Fn, choice &&>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), choice &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, choice &&>)
     requires typelist_type_invocable<Fn, choice &&>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), choice &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, choice const &&>)
     requires typelist_invocable<Fn, choice const &&> && (not typelist_type_invocable<Fn, choice const &&>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), choice const &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, choice const &&>)
     requires typelist_type_invocable<Fn, choice const &&>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), choice const &&>::type;
-    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index, FWD(fn));
+    return detail::invoke_variadic_union<type, typename _impl::data_t>(std::move(_impl::data), _impl::index,
+                                                                       detail::_unboxing<_impl::_has_box>(FWD(fn)));
   }
 
-  template <typename Fn> constexpr auto and_then(Fn &&fn) & noexcept -> decltype(this->transform_to(FWD(fn)))
+  template <typename Fn> constexpr auto and_then(Fn &&fn) & noexcept(noexcept(this->transform_to(FWD(fn))))
+      -> decltype(this->transform_to(FWD(fn)))
   {
     static_assert(some_choice<decltype(this->transform_to(FWD(fn)))>);
     return this->transform_to(FWD(fn));
   }
 
-  template <typename Fn> constexpr auto and_then(Fn &&fn) const & noexcept -> decltype(this->transform_to(FWD(fn)))
+  template <typename Fn> constexpr auto and_then(Fn &&fn) const & noexcept(noexcept(this->transform_to(FWD(fn))))
+      -> decltype(this->transform_to(FWD(fn)))
   {
     static_assert(some_choice<decltype(this->transform_to(FWD(fn)))>);
     return this->transform_to(FWD(fn));
   }
 
   template <typename Fn>
-  constexpr auto and_then(Fn &&fn) && noexcept -> decltype(std::move(*this).transform_to(FWD(fn)))
+  constexpr auto and_then(Fn &&fn) && noexcept(noexcept(std::move(*this).transform_to(FWD(fn))))
+      -> decltype(std::move(*this).transform_to(FWD(fn)))
   {
     static_assert(some_choice<decltype(std::move(*this).transform_to(FWD(fn)))>);
     return std::move(*this).transform_to(FWD(fn));
   }
 
   template <typename Fn>
-  constexpr auto and_then(Fn &&fn) const && noexcept -> decltype(std::move(*this).transform_to(FWD(fn)))
+  constexpr auto and_then(Fn &&fn) const && noexcept(noexcept(std::move(*this).transform_to(FWD(fn))))
+      -> decltype(std::move(*this).transform_to(FWD(fn)))
   {
     static_assert(some_choice<decltype(std::move(*this).transform_to(FWD(fn)))>);
     return std::move(*this).transform_to(FWD(fn));
@@ -257,13 +303,7 @@ template <typename... Ts, typename... Tx>
   requires(... && (std::equality_comparable<Ts> || not detail::type_one_of<Ts, Tx...>))
           and (not std::is_same_v<choice<Ts...>, choice<Tx...>>)
 {
-  return lh.template transform_to<bool>([&rh]<typename T>(std::in_place_type_t<T> d, auto const &lh) noexcept {
-    if constexpr (std::remove_cvref_t<decltype(rh)>::template has_type<T>) {
-      return rh.has_value(d) && lh == *rh.get_ptr(d); // GCOVR_EXCL_BR_LINE
-    } else {
-      return false;
-    }
-  });
+  return detail::_equal_sums_dispatch(lh.value(), rh.value());
 }
 
 template <typename... Ts, typename... Tx>
@@ -273,6 +313,14 @@ template <typename... Ts, typename... Tx>
   return not(lh == rh);
 }
 
+template <typename... Ts>
+[[nodiscard]] constexpr auto operator<=>(choice<Ts...> const &lh, choice<Ts...> const &rh) noexcept
+    -> std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>
+  requires(... && std::three_way_comparable<Ts>)
+{
+  return lh.value() <=> rh.value();
+}
+
 template <typename... Ts> using choice_for = detail::normalized<Ts...>::template apply<choice>;
 
 } // namespace fn
@@ -99,17 +99,23 @@ template <typename Fn, typename... Args>
   requires(sizeof...(Args) != 1)
           || ((not _some_pack<detail::select_nth_t<0, Args...>>) && (not _some_sum<detail::select_nth_t<0, Args...>>))
 struct _is_nothrow_invocable<Fn, Args...> : ::std::is_nothrow_invocable<Fn, Args...> {};
+// NOTE The `invoke` member functions of pack and sum are noexcept only if the function is, for every element of the
+// pack or for every alternative of the sum (including the conversion of the result, if any)
+template <typename Fn, typename Arg>
+constexpr auto _is_nothrow_invocable_result(Fn &&, Arg &&)
+    -> std::bool_constant<noexcept(std::declval<Arg>().invoke(std::declval<Fn>()))>;
+template <typename Fn, typename Arg> constexpr auto _is_nothrow_invocable_result(auto &&...) -> std::false_type;
 template <typename Fn, typename Arg>
   requires _some_pack<Arg>
 struct _is_nothrow_invocable<Fn, Arg> {
-  // TODO https://github.com/libfn/functional/issues/45
-  static constexpr bool value = _is_invocable<Fn, Arg>::value;
+  static constexpr bool value
+      = decltype(_is_nothrow_invocable_result<Fn, Arg>(std::declval<Fn>(), std::declval<Arg>()))::value;
 };
 template <typename Fn, typename Arg>
   requires _some_sum<Arg>
 struct _is_nothrow_invocable<Fn, Arg> {
-  // TODO https://github.com/libfn/functional/issues/45
-  static constexpr bool value = _is_invocable<Fn, Arg>::value;
+  static constexpr bool value
+      = decltype(_is_nothrow_invocable_result<Fn, Arg>(std::declval<Fn>(), std::declval<Arg>()))::value;
 };
 template <typename Fn, typename... Args>
 constexpr inline bool _is_nothrow_invocable_v = _is_nothrow_invocable<Fn, Args...>::value;
@@ -123,14 +129,22 @@ struct _is_nothrow_invocable_r<Ret, Fn, Args...> : ::std::is_nothrow_invocable_r
 template <typename Ret, typename Fn, typename Arg>
   requires _some_pack<Arg>
 struct _is_nothrow_invocable_r<Ret, Fn, Arg> {
-  // TODO https://github.com/libfn/functional/issues/45
-  static constexpr bool value = _is_invocable_r<Ret, Fn, Arg>::value;
+  static constexpr bool value = _is_invocable_r<Ret, Fn, Arg>::value && _is_nothrow_invocable<Fn, Arg>::value
+                                && ::std::is_nothrow_convertible_v<_invoke_result_t<Fn, Arg>, Ret>;
+};
+
+template <bool, typename Ret, typename Fn, typename Arg> struct _is_nothrow_invocable_r_result;
+template <typename Ret, typename Fn, typename Arg> struct _is_nothrow_invocable_r_result<false, Ret, Fn, Arg> {
+  static constexpr bool value = false;
+};
+template <typename Ret, typename Fn, typename Arg> struct _is_nothrow_invocable_r_result<true, Ret, Fn, Arg> {
+  static constexpr bool value = noexcept(std::declval<Arg>().template invoke_r<Ret>(std::declval<Fn>()));
 };
 template <typename Ret, typename Fn, typename Arg>
   requires _some_sum<Arg>
 struct _is_nothrow_invocable_r<Ret, Fn, Arg> {
-  // TODO https://github.com/libfn/functional/issues/45
-  static constexpr bool value = _is_invocable_r<Ret, Fn, Arg>::value;
+  static constexpr bool value
+      = _is_nothrow_invocable_r_result<_is_invocable_r<Ret, Fn, Arg>::value, Ret, Fn, Arg>::value;
 };
 template <typename Ret, typename Fn, typename... Args>
 constexpr inline bool _is_nothrow_invocable_r_v = _is_nothrow_invocable_r<Ret, Fn, Args...>::value;
@@ -179,61 +193,129 @@ constexpr Ret _invoke_r(Fn &&fn, Arg &&arg) noexcept(_is_nothrow_invocable_r_v<R
   return FWD(arg).template invoke_r<Ret>(FWD(fn));
 }
 
+// NOTE Error paths of monadic operations i.e. construction of an error, or invocation of a function on an error. If
+// FUNCTIONAL_COLD_ERRORS is defined to non-zero, these are moved out of line to functions marked `cold`, for programs
+// where errors are rare. The value path is then smaller, and the branch to the error path is predicted not taken.
+// This must be set the same way in every translation unit of the program.
+#ifndef FUNCTIONAL_COLD_ERRORS
+#define FUNCTIONAL_COLD_ERRORS 0
+#endif
+constexpr inline bool _cold_errors = FUNCTIONAL_COLD_ERRORS != 0;
+
+template <typename Fn> [[gnu::cold, gnu::noinline]] constexpr auto _error_path_cold(Fn &&fn) -> decltype(auto)
+{
+  return FWD(fn)();
+}
+
+template <typename Fn> constexpr auto _error_path(Fn &&fn) -> decltype(auto)
+{
+  if constexpr (_cold_errors)
+    return _error_path_cold(FWD(fn));
+  else
+    return FWD(fn)();
+}
+
+// NOTE Functions invoked on `sum` or `choice` see the value held by a `box<T>` alternative, rather than the box
+template <template <typename...> typename Tpl, typename T> struct _visible final {
+  using type = T;
+};
+template <typename T> struct _visible<::fn::sum, ::fn::box<T>> final {
+  using type = T;
+};
+template <typename T> struct _visible<::fn::choice, ::fn::box<T>> final {
+  using type = T;
+};
+template <template <typename...> typename Tpl, typename T> using _visible_t = typename _visible<Tpl, T>::type;
+
 template <typename Fn, typename T> constexpr inline bool _is_ts_invocable = false;
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> &> = (... && _is_invocable_v<Fn, Ts &>);
+constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> &> = (... && _is_invocable_v<Fn, _visible_t<Tpl, Ts> &>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> const &> = (... && _is_invocable_v<Fn, Ts const &>);
+constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> const &>
+    = (... && _is_invocable_v<Fn, _visible_t<Tpl, Ts> const &>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> &&> = (... && _is_invocable_v<Fn, Ts &&>);
+constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> &&> = (... && _is_invocable_v<Fn, _visible_t<Tpl, Ts> &&>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> const &&> = (... && _is_invocable_v<Fn, Ts const &&>);
+constexpr inline bool _is_ts_invocable<Fn, Tpl<Ts...> const &&>
+    = (... && _is_invocable_v<Fn, _visible_t<Tpl, Ts> const &&>);
 template <typename Fn, typename T>
 concept _typelist_invocable = _is_ts_invocable<Fn, T &&>;
 
 template <typename R, typename Fn, typename T> constexpr inline bool _is_rts_invocable = false;
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> &> = (... && _is_invocable_r_v<R, Fn, Ts &>);
+constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> &> = (... && _is_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> &>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> const &> = (... && _is_invocable_r_v<R, Fn, Ts const &>);
+constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> const &>
+    = (... && _is_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> const &>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> &&> = (... && _is_invocable_r_v<R, Fn, Ts &&>);
+constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> &&>
+    = (... && _is_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> &&>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
-constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> const &&> = (... && _is_invocable_r_v<R, Fn, Ts const &&>);
+constexpr inline bool _is_rts_invocable<R, Fn, Tpl<Ts...> const &&>
+    = (... && _is_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> const &&>);
 template <typename R, typename Fn, typename T>
 concept _typelist_invocable_r = _is_rts_invocable<R, Fn, T &&>;
 
 template <typename Fn, typename T> constexpr inline bool _is_tst_invocable = false;
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_tst_invocable<Fn, Tpl<Ts...> &>
-    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<Ts>, Ts &>);
+    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_tst_invocable<Fn, Tpl<Ts...> const &>
-    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<Ts>, Ts const &>);
+    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_tst_invocable<Fn, Tpl<Ts...> &&>
-    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<Ts>, Ts &&>);
+    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &&>);
 template <typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_tst_invocable<Fn, Tpl<Ts...> const &&>
-    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<Ts>, Ts const &&>);
+    = (... && _is_invocable_v<Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &&>);
 template <typename Fn, typename T>
 concept _typelist_type_invocable = _is_tst_invocable<Fn, T &&>;
 
 template <typename R, typename Fn, typename T> constexpr inline bool _is_rtst_invocable = false;
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_rtst_invocable<R, Fn, Tpl<Ts...> &>
-    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<Ts>, Ts &>);
+    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_rtst_invocable<R, Fn, Tpl<Ts...> const &>
-    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<Ts>, Ts const &>);
+    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_rtst_invocable<R, Fn, Tpl<Ts...> &&>
-    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<Ts>, Ts &&>);
+    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &&>);
 template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
 constexpr inline bool _is_rtst_invocable<R, Fn, Tpl<Ts...> const &&>
-    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<Ts>, Ts const &&>);
+    = (... && _is_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &&>);
 template <typename R, typename Fn, typename T>
 concept _typelist_type_invocable_r = _is_rtst_invocable<R, Fn, T &&>;
+
+// NOTE Invocation of `fn` with any of the alternatives, and conversion of its result to `R`, does not throw
+template <typename R, typename Fn, typename T> constexpr inline bool _is_nothrow_rts_invocable = false;
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rts_invocable<R, Fn, Tpl<Ts...> &>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> &>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rts_invocable<R, Fn, Tpl<Ts...> const &>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> const &>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rts_invocable<R, Fn, Tpl<Ts...> &&>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> &&>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rts_invocable<R, Fn, Tpl<Ts...> const &&>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, _visible_t<Tpl, Ts> const &&>);
+
+template <typename R, typename Fn, typename T> constexpr inline bool _is_nothrow_rtst_invocable = false;
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rtst_invocable<R, Fn, Tpl<Ts...> &>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rtst_invocable<R, Fn, Tpl<Ts...> const &> = (... && _is_nothrow_invocable_r_v<
+    R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rtst_invocable<R, Fn, Tpl<Ts...> &&>
+    = (... && _is_nothrow_invocable_r_v<R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> &&>);
+template <typename R, typename Fn, template <typename...> typename Tpl, typename... Ts>
+constexpr inline bool _is_nothrow_rtst_invocable<R, Fn, Tpl<Ts...> const &&> = (... && _is_nothrow_invocable_r_v<
+    R, Fn, ::std::in_place_type_t<_visible_t<Tpl, Ts>>, _visible_t<Tpl, Ts> const &&>);
 } // namespace fn::detail
 
 #endif // INCLUDE_FUNCTIONAL_DETAIL_FUNCTIONAL
@@ -6,6 +6,8 @@
 #ifndef INCLUDE_FUNCTIONAL_DETAIL_FWD
 #define INCLUDE_FUNCTIONAL_DETAIL_FWD
 
+#include <cstddef>
+
 namespace fn {
 // NOTE Some forward declarations can lead to hard to troubleshoot compilation
 //      errors. Only declare select, useful datatypes here.
@@ -50,6 +52,26 @@ template <typename T>
 concept _some_choice = _is_some_choice<T &>;
 } // namespace detail
 
+// owning pointer, for recursive alternatives of choice and sum
+template <typename T> struct box;
+namespace detail {
+template <typename T> constexpr bool _is_some_box = false;
+template <typename T> constexpr bool _is_some_box<::fn::box<T> &> = true;
+template <typename T> constexpr bool _is_some_box<::fn::box<T> const &> = true;
+template <typename T>
+concept _some_box = _is_some_box<T &>;
+} // namespace detail
+
+// type-erased value with inline storage, an open alternative to sum
+template <std::size_t Size = 4 * sizeof(void *)> struct open_sum;
+namespace detail {
+template <typename T> constexpr bool _is_some_open_sum = false;
+template <std::size_t Size> constexpr bool _is_some_open_sum<::fn::open_sum<Size> &> = true;
+template <std::size_t Size> constexpr bool _is_some_open_sum<::fn::open_sum<Size> const &> = true;
+template <typename T>
+concept _some_open_sum = _is_some_open_sum<T &>;
+} // namespace detail
+
 // product of types
 template <typename... Ts> struct pack;
 namespace detail {
@@ -68,6 +90,8 @@ template <typename... Ts> constexpr bool _is_sum<::fn::sum<Ts...> &> = true;
 template <typename... Ts> constexpr bool _is_sum<::fn::sum<Ts...> const &> = true;
 template <typename T>
 concept _some_sum = detail::_is_sum<T &>;
+template <typename... Ts>
+concept _some_sums = (sizeof...(Ts) > 1) && (... && _some_sum<Ts>);
 } // namespace detail
 } // namespace fn
 
@@ -9,9 +9,8 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
-#include <string>
+#include <cstdint>
 #include <string_view>
-#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -29,11 +28,19 @@ struct select_nth<N, Ts...> {
   using type = __type_pack_element<N, Ts...>;
 };
 #else
+// NOTE Overload resolution against a list of bases, which is instantiated once per list of types, is much cheaper
+// than instantiating std::tuple and std::tuple_element for every lookup in a long list of types
+template <std::size_t N, typename T> struct _nth_type {};
+template <typename, typename... Ts> struct _nth_type_list;
+template <std::size_t... Is, typename... Ts>
+struct _nth_type_list<std::index_sequence<Is...>, Ts...> : _nth_type<Is, Ts>... {};
+template <std::size_t N, typename T> auto _select_nth(_nth_type<N, T> const &) -> std::type_identity<T>;
+
 template <std::size_t N, typename... Ts>
   requires(sizeof...(Ts) > 0)
 struct select_nth<N, Ts...> {
   static_assert(N < (sizeof...(Ts)));
-  using type = std::tuple_element_t<N, std::tuple<Ts...>>;
+  using type = decltype(_select_nth<N>(_nth_type_list<std::index_sequence_for<Ts...>, Ts...>{}))::type;
 };
 #endif
 
@@ -52,6 +59,11 @@ constexpr inline std::size_t type_index = static_cast<_indexed_type<T> const &>(
 
 template <typename T, typename... Ts> constexpr inline bool type_one_of = (... || __is_same_as(Ts, T));
 
+// NOTE Smallest unsigned integral type able to store any index in [0, N)
+template <std::size_t N>
+using select_index_t = std::conditional_t<(N <= UINT8_MAX), std::uint8_t,
+                                          std::conditional_t<(N <= UINT16_MAX), std::uint16_t, std::uint32_t>>;
+
 #ifdef __clang__
 static constexpr std::string_view _normalized_name_anon{"(anonymous namespace)"};
 static constexpr std::string_view _normalized_name_prefix{"sortkey() [T = "};
@@ -59,56 +71,113 @@ static constexpr std::string_view _normalized_name_prefix{"sortkey() [T = "};
 static constexpr std::string_view _normalized_name_anon{"{anonymous}"};
 static constexpr std::string_view _normalized_name_prefix{"sortkey() [with T = "};
 #endif
+static constexpr std::string_view _normalized_name_anon_in{"(anonymous namespace in "};
 static constexpr std::size_t _normalized_name_TU_name_bound = 30;
 
-template <auto TU_name, auto Input> struct _normalized_name final {
-  template <std::size_t N> static constexpr auto apply() noexcept
+// NOTE Name of a type, as found in __PRETTY_FUNCTION__ of a function template, and the (trimmed) name of the
+// translation unit, to disambiguate anonymous namespaces. The name is only scanned, never copied to a std::string
+struct _normalized_name final {
+  std::string_view file;
+  std::string_view name;
+
+  [[nodiscard]] static constexpr auto make(std::string_view tu_name, std::string_view input) noexcept
+      -> _normalized_name
   {
-    std::string_view const sv{Input.data(), Input.size()};
-    std::size_t s = sv.find(_normalized_name_prefix);
-    std::string_view file{TU_name.size() <= _normalized_name_TU_name_bound
-                              ? TU_name.data()
-                              : TU_name.data() + (TU_name.size() - _normalized_name_TU_name_bound - 1),
-                          std::min(TU_name.size() - 1, _normalized_name_TU_name_bound)};
-
-    std::string result;
-    s += _normalized_name_prefix.size();
-    while (true) {
-      std::size_t i = sv.find(_normalized_name_anon, s);
-      if (i != std::string_view::npos) {
-        result.append(sv.substr(s, i - s));
-        result.append(std::string_view("(anonymous namespace in "));
-        result.append(file);
-        result.append(std::string_view(")"));
-      } else {
-        result.append(sv.substr(s, sv.size() - s - 2));
-        break;
-      }
-      s = i + _normalized_name_anon.size();
-    };
-
-    if constexpr (N == 0)
-      return result.size();
-    else {
-      std::array<char, N> a;
-      for (std::size_t i = 0; i < result.size(); ++i) {
-        a[i] = result[i];
-      }
-      return a;
+    std::size_t const s = input.find(_normalized_name_prefix) + _normalized_name_prefix.size();
+    return {tu_name.substr(tu_name.size() - std::min(tu_name.size(), _normalized_name_TU_name_bound)),
+            input.substr(s, input.size() - s - 1)};
+  }
+
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+  {
+    std::size_t result = name.size();
+    for (std::size_t i = name.find(_normalized_name_anon); i != std::string_view::npos;
+         i = name.find(_normalized_name_anon, i + _normalized_name_anon.size())) {
+      result += _normalized_name_anon_in.size() + file.size() + 1 - _normalized_name_anon.size();
     }
+    return result;
   }
 
-  static constexpr auto _slice = apply<apply<0>()>();
-  static constexpr std::string_view value{_slice.data(), _slice.size()};
+  template <std::size_t N> [[nodiscard]] constexpr auto apply() const noexcept -> std::array<char, N>
+  {
+    std::array<char, N> result = {};
+    auto out = result.begin();
+    std::size_t s = 0;
+    for (std::size_t i = name.find(_normalized_name_anon); i != std::string_view::npos;
+         i = name.find(_normalized_name_anon, s)) {
+      out = std::copy(name.begin() + s, name.begin() + i, out);
+      out = std::copy(_normalized_name_anon_in.begin(), _normalized_name_anon_in.end(), out);
+      out = std::copy(file.begin(), file.end(), out);
+      *out++ = ')';
+      s = i + _normalized_name_anon.size();
+    }
+    std::copy(name.begin() + s, name.end(), out);
+    return result;
+  }
 };
 
 namespace sortkey {
-template <typename T> [[nodiscard]] static constexpr auto _make_sortkey()
+template <typename T> [[nodiscard]] static constexpr auto _make_sortkey() noexcept -> _normalized_name
 {
-  return _normalized_name<std::to_array(__BASE_FILE__), std::to_array(__PRETTY_FUNCTION__)>::value;
+  return _normalized_name::make(__BASE_FILE__, __PRETTY_FUNCTION__);
 }
 } // namespace sortkey
-template <typename T> constexpr inline std::string_view type_sortkey_v = sortkey::_make_sortkey<T>();
+
+// NOTE Sort key of a type, computed once per type and memoized in static data members. Other than the name itself, it
+// is also stored as an array of 64-bit words, each holding 8 consecutive characters in big-endian order (padded with
+// zeros), so that comparing words yields the lexicographic order of names, 8 characters at a time. There is no hash;
+// the first word is the same for all names which only differ after the first 8 characters (e.g. types in the same
+// namespace), so it rarely decides the order by itself; the speedup over comparing names comes from memoization.
+template <typename T> struct _sortkey final {
+  static constexpr _normalized_name _name = sortkey::_make_sortkey<T>();
+  static constexpr std::array<char, _name.size()> _slice = _name.template apply<_name.size()>();
+  static constexpr std::string_view value{_slice.data(), _slice.size()};
+  static constexpr std::array<std::uint64_t, (_slice.size() + 7) / 8> words = [] {
+    std::array<std::uint64_t, (_slice.size() + 7) / 8> result = {};
+    for (std::size_t i = 0; i < result.size() * 8; ++i)
+      result[i / 8] = (result[i / 8] << 8) | (i < _slice.size() ? static_cast<unsigned char>(_slice[i]) : 0u);
+    return result;
+  }();
+};
+
+template <typename T> constexpr inline std::string_view type_sortkey_v = _sortkey<T>::value;
+
+// NOTE FNV-1a, does not depend on the platform or on the standard library
+[[nodiscard]] constexpr auto _fnv1a(std::string_view v) noexcept -> std::uint64_t
+{
+  std::uint64_t result = 0xcbf29ce484222325ull;
+  for (char const c : v) {
+    result ^= static_cast<unsigned char>(c);
+    result *= 0x100000001b3ull;
+  }
+  return result;
+}
+
+struct _sortkey_ref final {
+  std::uint64_t const *words;
+  std::size_t size;
+
+  template <typename T> static constexpr auto make() noexcept -> _sortkey_ref
+  {
+    return {_sortkey<T>::words.data(), _sortkey<T>::words.size()};
+  }
+
+  [[nodiscard]] constexpr bool operator<(_sortkey_ref const &rh) const noexcept
+  {
+    if (words[0] != rh.words[0])
+      return words[0] < rh.words[0];
+    for (std::size_t i = 1; i < size && i < rh.size; ++i) {
+      if (words[i] != rh.words[i])
+        return words[i] < rh.words[i];
+    }
+    return size < rh.size;
+  }
+
+  [[nodiscard]] constexpr bool operator==(_sortkey_ref const &rh) const noexcept
+  {
+    return words[0] == rh.words[0] && std::equal(words, words + size, rh.words, rh.words + rh.size);
+  }
+};
 
 // NOTE Normalized order of types - order based on type_sortkey_v
 template <typename... Ts> struct normalized final {
@@ -121,14 +190,18 @@ template <typename... Ts> struct normalized final {
 
   [[nodiscard]] static constexpr auto _indices() noexcept
   {
-    std::array<std::string_view, sizeof...(Ts)> names{type_sortkey_v<Ts>...};
     std::array<std::size_t, sizeof...(Ts)> indices;
     std::generate(indices.begin(), indices.end(), [n = 0]() mutable -> std::size_t { return n++; });
-    auto const less = [v = &names](std::size_t i, std::size_t j) constexpr { return (*v)[i] < (*v)[j]; };
-    std::sort(indices.begin(), indices.end(), less);
-    auto const equal = [v = &names](std::size_t i, std::size_t j) constexpr { return (*v)[i] == (*v)[j]; };
-    auto const end = std::unique(indices.begin(), indices.end(), equal);
-    return _uniqued{indices, static_cast<std::size_t>(end - indices.begin())};
+    if constexpr (N < 2) {
+      return _uniqued{indices, N};
+    } else {
+      std::array<_sortkey_ref, sizeof...(Ts)> const keys{_sortkey_ref::make<Ts>()...};
+      auto const less = [v = &keys](std::size_t i, std::size_t j) constexpr { return (*v)[i] < (*v)[j]; };
+      std::sort(indices.begin(), indices.end(), less);
+      auto const equal = [v = &keys](std::size_t i, std::size_t j) constexpr { return (*v)[i] == (*v)[j]; };
+      auto const end = std::unique(indices.begin(), indices.end(), equal);
+      return _uniqued{indices, static_cast<std::size_t>(end - indices.begin())};
+    }
   }
 
   static constexpr _uniqued _indices_v = _indices();
@@ -0,0 +1,305 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_DETAIL_PACK_EXPR
+#define INCLUDE_FUNCTIONAL_DETAIL_PACK_EXPR
+
+#include "functional.hpp"
+#include "fwd.hpp"
+#include "fwd_macro.hpp"
+#include "meta.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fn::detail {
+// NOTE Elements contributed to the pack by an operand of `operator&`, with void contributing none
+template <typename P, typename V> struct _pack_expr_append;
+template <typename... Ts, typename V> struct _pack_expr_append<::fn::pack<Ts...>, V> final {
+  using type = ::fn::pack<Ts..., V>;
+};
+template <typename... Ts> struct _pack_expr_append<::fn::pack<Ts...>, void> final {
+  using type = ::fn::pack<Ts...>;
+};
+template <typename... Ts, typename... Vs> struct _pack_expr_append<::fn::pack<Ts...>, ::fn::pack<Vs...>> final {
+  using type = ::fn::pack<Ts..., Vs...>;
+};
+
+template <typename P, typename... Vs> struct _pack_expr_values final {
+  using type = P;
+};
+template <typename P, typename V, typename... Vs> struct _pack_expr_values<P, V, Vs...> final {
+  using type = typename _pack_expr_values<typename _pack_expr_append<P, V>::type, Vs...>::type;
+};
+
+template <typename Op> [[nodiscard]] constexpr auto _pack_expr_refs(Op &&op) noexcept
+{
+  using value_type = typename std::remove_cvref_t<Op>::value_type;
+  if constexpr (std::is_void_v<value_type>)
+    return std::tuple<>{};
+  else if constexpr (_some_pack<value_type>)
+    return (*FWD(op)).invoke([](auto &&...args) noexcept { return std::forward_as_tuple(FWD(args)...); });
+  else
+    return std::forward_as_tuple(*FWD(op));
+}
+
+template <typename Fn, typename Refs> struct _pack_expr_result;
+template <typename Fn, typename... Rs> struct _pack_expr_result<Fn, std::tuple<Rs...>> final {
+  using type = _invoke_result_t<Fn, Rs...>;
+};
+
+template <typename P, typename Refs> constexpr bool _is_nothrow_pack_expr_build = false;
+template <typename P, typename... Rs>
+constexpr bool _is_nothrow_pack_expr_build<P, std::tuple<Rs...>> = noexcept(P{std::declval<Rs>()...});
+
+template <typename Rh, typename E>
+concept _pack_expr_same_error = _some_expected<Rh> && std::same_as<typename std::remove_cvref_t<Rh>::error_type, E>;
+
+template <typename T, typename Rh> constexpr bool _pack_expr_compatible = false;
+template <typename T, typename E, typename Rh>
+constexpr bool _pack_expr_compatible<::fn::expected<T, E>, Rh> = _pack_expr_same_error<Rh, E>;
+template <typename T, typename Rh>
+constexpr bool _pack_expr_compatible<::fn::optional<T>, Rh> = _some_optional<Rh>;
+
+template <typename T, typename V> struct _pack_expr_type;
+template <typename T, typename E, typename V> struct _pack_expr_type<::fn::expected<T, E>, V> final {
+  using type = ::fn::expected<V, E>;
+  static constexpr bool nothrow_error
+      = std::is_nothrow_copy_constructible_v<E> && std::is_nothrow_move_constructible_v<E>;
+};
+template <typename T, typename V> struct _pack_expr_type<::fn::optional<T>, V> final {
+  using type = ::fn::optional<V>;
+  static constexpr bool nothrow_error = true;
+};
+
+// NOTE Like `std::views::all`, refer to lvalue operands and take ownership of rvalue operands
+template <typename Op>
+using _pack_expr_operand_t = std::conditional_t<std::is_lvalue_reference_v<Op>, Op, std::remove_cvref_t<Op>>;
+
+template <typename Op>
+constexpr bool _is_nothrow_pack_expr_operand = std::is_nothrow_constructible_v<_pack_expr_operand_t<Op>, Op>;
+
+// NOTE Result of `operator&` on `expected` or `optional` with more than one value. Rather than moving the values into
+// a new `pack` at every step, a chain `a & b & c & d` collects its operands and builds one `pack` when the result is
+// consumed. With `transform` and `and_then` no `pack` is built at all, and the values are passed directly to the
+// function. Operands are held as `_pack_expr_operand_t`, so the result can be kept for as long as its lvalue operands
+// are alive. The value of an lvalue operand is copied into the `pack` once and never moved. The value of an rvalue
+// operand is moved into the result of `operator&`, again by each following `operator&` in the chain, and then once
+// into the `pack`.
+template <typename... Ops> struct pack_expr final {
+  static_assert(sizeof...(Ops) >= 2);
+
+  using _first = std::remove_cvref_t<select_nth_t<0, Ops...>>;
+  static constexpr bool _is_expected = _some_expected<_first>;
+  using value_type =
+      typename _pack_expr_values<::fn::pack<>, typename std::remove_cvref_t<Ops>::value_type...>::type;
+  using type = typename _pack_expr_type<_first, value_type>::type;
+
+  std::tuple<Ops...> _ops;
+
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ops))
+  constexpr explicit pack_expr(Args &&...args) noexcept((... && std::is_nothrow_constructible_v<Ops, Args>))
+      : _ops(FWD(args)...)
+  {
+  }
+
+  [[nodiscard]] constexpr bool has_value() const noexcept
+  {
+    return std::apply([](auto const &...ops) noexcept { return (... && ops.has_value()); }, _ops);
+  }
+
+  // NOTE Precondition: not has_value()
+  template <typename F = _first>
+  [[nodiscard]] constexpr auto error() const & -> typename F::error_type
+    requires _is_expected
+  {
+    return _error(*this);
+  }
+
+  template <typename F = _first>
+  [[nodiscard]] constexpr auto error() && -> typename F::error_type
+    requires _is_expected
+  {
+    return _error(std::move(*this));
+  }
+
+  [[nodiscard]] constexpr auto value() const & -> value_type { return _value(*this); }
+  [[nodiscard]] constexpr auto value() && -> value_type { return _value(std::move(*this)); }
+
+  template <typename Fn> constexpr auto transform(Fn &&fn) const & { return _transform(*this, FWD(fn)); }
+  template <typename Fn> constexpr auto transform(Fn &&fn) && { return _transform(std::move(*this), FWD(fn)); }
+
+  template <typename Fn> constexpr auto and_then(Fn &&fn) const & { return _and_then(*this, FWD(fn)); }
+  template <typename Fn> constexpr auto and_then(Fn &&fn) && { return _and_then(std::move(*this), FWD(fn)); }
+
+  [[nodiscard]] constexpr operator type() const & noexcept(_is_nothrow_materialize<pack_expr const &>())
+  {
+    return _materialize(*this);
+  }
+
+  [[nodiscard]] constexpr operator type() && noexcept(_is_nothrow_materialize<pack_expr>())
+  {
+    return _materialize(std::move(*this));
+  }
+
+  // NOTE Functors e.g. `a & b | fn::transform(...)` are applied to the materialized `type`
+  [[nodiscard]] constexpr friend auto operator|(pack_expr const &self, auto &&fn)
+      -> decltype(std::declval<type>() | FWD(fn))
+  {
+    return type(self) | FWD(fn);
+  }
+
+  [[nodiscard]] constexpr friend auto operator|(pack_expr &&self, auto &&fn)
+      -> decltype(std::declval<type>() | FWD(fn))
+  {
+    return type(std::move(self)) | FWD(fn);
+  }
+
+  template <typename Rh>
+    requires _pack_expr_compatible<_first, Rh> && (not _some_pack<typename std::remove_cvref_t<Rh>::value_type>)
+  [[nodiscard]] constexpr friend auto operator&(pack_expr const &lh, Rh &&rh) noexcept(
+      (... && std::is_nothrow_copy_constructible_v<Ops>) && _is_nothrow_pack_expr_operand<Rh>)
+      -> pack_expr<Ops..., _pack_expr_operand_t<Rh>>
+  {
+    using type = pack_expr<Ops..., _pack_expr_operand_t<Rh>>;
+    return std::apply([&rh](auto &&...ops) { return type(FWD(ops)..., FWD(rh)); }, lh._ops);
+  }
+
+  template <typename Rh>
+    requires _pack_expr_compatible<_first, Rh> && (not _some_pack<typename std::remove_cvref_t<Rh>::value_type>)
+  [[nodiscard]] constexpr friend auto operator&(pack_expr &&lh, Rh &&rh) noexcept(
+      (... && std::is_nothrow_move_constructible_v<Ops>) && _is_nothrow_pack_expr_operand<Rh>)
+      -> pack_expr<Ops..., _pack_expr_operand_t<Rh>>
+  {
+    using type = pack_expr<Ops..., _pack_expr_operand_t<Rh>>;
+    return std::apply([&rh](auto &&...ops) { return type(FWD(ops)..., FWD(rh)); }, std::move(lh._ops));
+  }
+
+  template <typename Lh>
+    requires _pack_expr_compatible<_first, Lh> && std::is_void_v<typename std::remove_cvref_t<Lh>::value_type>
+  [[nodiscard]] constexpr friend auto operator&(Lh &&lh, pack_expr const &rh) noexcept(
+      _is_nothrow_pack_expr_operand<Lh> && (... && std::is_nothrow_copy_constructible_v<Ops>))
+      -> pack_expr<_pack_expr_operand_t<Lh>, Ops...>
+  {
+    using type = pack_expr<_pack_expr_operand_t<Lh>, Ops...>;
+    return std::apply([&lh](auto &&...ops) { return type(FWD(lh), FWD(ops)...); }, rh._ops);
+  }
+
+  template <typename Lh>
+    requires _pack_expr_compatible<_first, Lh> && std::is_void_v<typename std::remove_cvref_t<Lh>::value_type>
+  [[nodiscard]] constexpr friend auto operator&(Lh &&lh, pack_expr &&rh) noexcept(
+      _is_nothrow_pack_expr_operand<Lh> && (... && std::is_nothrow_move_constructible_v<Ops>))
+      -> pack_expr<_pack_expr_operand_t<Lh>, Ops...>
+  {
+    using type = pack_expr<_pack_expr_operand_t<Lh>, Ops...>;
+    return std::apply([&lh](auto &&...ops) { return type(FWD(lh), FWD(ops)...); }, std::move(rh._ops));
+  }
+
+  // NOTE Values of owned operands are moved out of an rvalue `Self`, all other values are copied
+  template <typename Self> [[nodiscard]] static constexpr auto _refs(Self &&self) noexcept
+  {
+    if constexpr (std::is_const_v<std::remove_reference_t<Self>>)
+      return std::apply([](auto const &...ops) noexcept { return std::tuple_cat(_pack_expr_refs(ops)...); },
+                        self._ops);
+    else
+      return std::apply([](auto &&...ops) noexcept { return std::tuple_cat(_pack_expr_refs(FWD(ops))...); },
+                        std::move(self._ops));
+  }
+
+  // NOTE Builds the pack in place, when converted to `value_type` e.g. by the constructor of `expected` or `optional`
+  template <typename Self> struct _build final {
+    Self &&self;
+
+    constexpr operator value_type() && noexcept(
+        _is_nothrow_pack_expr_build<value_type, decltype(_refs(std::declval<Self>()))>)
+    {
+      return std::apply([](auto &&...args) { return value_type{FWD(args)...}; }, _refs(FWD(self)));
+    }
+  };
+
+  template <typename Self> static constexpr bool _is_nothrow_materialize() noexcept
+  {
+    return _is_nothrow_pack_expr_build<value_type, decltype(_refs(std::declval<Self>()))>
+           && _pack_expr_type<_first, value_type>::nothrow_error;
+  }
+
+  template <typename Self> static constexpr auto _materialize(Self &&self) -> type
+  {
+    if (self.has_value())
+      return type(std::in_place, _build<Self>{FWD(self)});
+    return _fail<type>(FWD(self));
+  }
+
+  template <typename Self> static constexpr auto _value(Self &&self) -> value_type
+  {
+    if (not self.has_value())
+      (void)type(FWD(self)).value(); // NOTE Throws
+    return _build<Self>{FWD(self)};
+  }
+
+  template <typename Self, typename Fn> static constexpr auto _apply(Self &&self, Fn &&fn) -> decltype(auto)
+  {
+    return std::apply(
+        [&fn](auto &&...args) -> decltype(auto) { return ::fn::detail::_invoke(FWD(fn), FWD(args)...); },
+        _refs(FWD(self)));
+  }
+
+  template <typename Self, typename Fn> static constexpr auto _transform(Self &&self, Fn &&fn)
+  {
+    using result_t = typename _pack_expr_result<Fn, decltype(_refs(std::declval<Self>()))>::type;
+    using type = typename _pack_expr_type<_first, result_t>::type;
+    if (self.has_value()) {
+      if constexpr (std::is_void_v<result_t>) {
+        _apply(FWD(self), FWD(fn));
+        return type();
+      } else {
+        return type(std::in_place, _apply(FWD(self), FWD(fn)));
+      }
+    }
+    return _fail<type>(FWD(self));
+  }
+
+  template <typename Self, typename Fn> static constexpr auto _and_then(Self &&self, Fn &&fn)
+  {
+    using type = typename _pack_expr_result<Fn, decltype(_refs(std::declval<Self>()))>::type;
+    static_assert(_pack_expr_compatible<_first, type>);
+    if (self.has_value())
+      return _apply(FWD(self), FWD(fn));
+    return _fail<type>(FWD(self));
+  }
+
+  template <typename T, std::size_t I = 0, typename Self> [[nodiscard]] static constexpr auto _fail(Self &&self) -> T
+  {
+    if constexpr (I + 1 < sizeof...(Ops)) {
+      if (std::get<I>(self._ops).has_value())
+        return _fail<T, I + 1>(FWD(self));
+    }
+    if constexpr (_is_expected)
+      return T(std::unexpect, std::get<I>(FWD(self)._ops).error());
+    else
+      return T(std::nullopt);
+  }
+
+  template <std::size_t I = 0, typename Self> [[nodiscard]] static constexpr auto _error(Self &&self)
+  {
+    if constexpr (I + 1 < sizeof...(Ops)) {
+      if (std::get<I>(self._ops).has_value())
+        return _error<I + 1>(FWD(self));
+    }
+    return typename _first::error_type(std::get<I>(FWD(self)._ops).error());
+  }
+};
+
+template <typename... Args> pack_expr(Args &&...) -> pack_expr<_pack_expr_operand_t<Args>...>;
+
+} // namespace fn::detail
+
+#endif // INCLUDE_FUNCTIONAL_DETAIL_PACK_EXPR
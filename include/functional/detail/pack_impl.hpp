@@ -7,10 +7,16 @@
 #define INCLUDE_FUNCTIONAL_DETAIL_PACK_IMPL
 
 #include "functional.hpp"
+#include "fwd.hpp"
 #include "fwd_macro.hpp"
+#include "meta.hpp"
 #include "traits.hpp"
 
+#include <array>
+#include <compare>
+#include <cstddef>
 #include <functional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -20,13 +26,164 @@ template <std::size_t I, typename T> struct _element {
   T v;
 };
 
+// NOTE Elements of empty types e.g. stateless lambdas or tags take no storage, unless the pack has more than one
+// element of the same type, which must have distinct addresses. Other elements do not use `[[no_unique_address]]`,
+// which would let the next element reuse their tail padding, so e.g. copying the bytes of one would overwrite another.
+template <std::size_t I, typename T>
+  requires std::is_empty_v<T>
+struct _element<I, T> {
+  [[no_unique_address]] T v;
+};
+
+// NOTE Elements in the order of bases, which is also their order in memory. The elements can be initialized in place
+// by `_make(fn)`, which calls `fn` with `std::type_identity<_element<I, T>>` for each element, in memory order.
+template <typename... Es> struct _pack_storage : Es... {
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto _make(Fn &&fn) noexcept((... && noexcept(fn(std::type_identity<Es>{}))))
+      -> _pack_storage
+  {
+    return {fn(std::type_identity<Es>{})...};
+  }
+};
+
+// NOTE Logical indices of elements sorted by descending alignment, otherwise in logical order. References are stored
+// as pointers, hence the alignment of `_element` rather than of the element type.
+template <typename... Ts> constexpr auto _pack_order = [] {
+  constexpr std::size_t align[] = {alignof(_element<0, Ts>)..., 0};
+  std::array<std::size_t, sizeof...(Ts)> result = {};
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    result[i] = i;
+    for (std::size_t j = i; j > 0 && align[result[j - 1]] < align[result[j]]; --j)
+      std::swap(result[j - 1], result[j]);
+  }
+  return result;
+}();
+
+// NOTE Elements are laid out in logical order, unless ordering them by alignment makes the pack smaller
+template <typename Is, typename... Ts> struct _pack_layout;
+template <std::size_t... Is, typename... Ts> struct _pack_layout<std::index_sequence<Is...>, Ts...> final {
+  static constexpr auto order = _pack_order<Ts...>;
+  using logical = _pack_storage<_element<Is, Ts>...>;
+  using physical = _pack_storage<_element<order[Is], select_nth_t<order[Is], Ts...>>...>;
+  static constexpr bool reordered = sizeof(physical) < sizeof(logical);
+  using type = std::conditional_t<reordered, physical, logical>;
+};
+
+struct _pack_init_tag final {};
+
+// NOTE Element `T` can be initialized from `Arg` like in aggregate initialization of a pack, so neither explicit
+// constructors nor narrowing conversions are allowed, but brace elision is. Checked with an array of `T`, unless `T` is
+// a reference.
+template <typename T, typename Arg>
+concept _pack_element_from = (std::is_reference_v<T> && std::is_convertible_v<Arg, T>)
+                             || requires { std::type_identity_t<T[]>{std::declval<Arg>()}; };
+
+template <typename T, typename Arg> constexpr bool _is_nothrow_pack_element_from = [] {
+  if constexpr (std::is_convertible_v<Arg, T>)
+    return std::is_nothrow_convertible_v<Arg, T>;
+  else
+    return noexcept(T{std::declval<Arg>()});
+}();
+
+template <typename... Args> struct _pack_from_args final {
+  std::tuple<Args &&...> args;
+
+  template <std::size_t I> using _arg = std::tuple_element_t<I, std::tuple<Args &&...>>;
+
+  template <std::size_t I, typename T>
+  constexpr auto operator()(std::type_identity<_element<I, T>>) noexcept(_is_nothrow_pack_element_from<T, _arg<I>>)
+      -> T
+  {
+    if constexpr (std::is_convertible_v<_arg<I>, T>)
+      return std::get<I>(std::move(args));
+    else
+      return {std::get<I>(std::move(args))}; // NOTE Brace elision
+  }
+};
+
+// NOTE Elements of `self`, followed by the new element constructed from `args`
+template <typename Self, typename... Args> struct _pack_from_append final {
+  Self &&self;
+  std::tuple<Args &&...> args;
+
+  template <std::size_t I, typename T> static constexpr bool _is_nothrow = [] {
+    if constexpr (I < std::remove_cvref_t<Self>::size)
+      return std::is_nothrow_constructible_v<T, apply_const_lvalue_t<Self, T &&>>;
+    else
+      return std::is_reference_v<T> || std::is_nothrow_constructible_v<T, Args...>;
+  }();
+
+  template <std::size_t I, typename T>
+  constexpr auto operator()(std::type_identity<_element<I, T>>) noexcept(_is_nothrow<I, T>) -> T
+  {
+    if constexpr (I < std::remove_cvref_t<Self>::size)
+      return static_cast<apply_const_lvalue_t<Self, T &&>>(FWD(self)._element<I, T>::v);
+    else if constexpr (std::is_reference_v<T>)
+      return std::get<0>(std::move(args));
+    else
+      return std::apply([](auto &&...args) noexcept(_is_nothrow<I, T>) -> T { return T{FWD(args)...}; },
+                        std::move(args));
+  }
+};
+
+// NOTE Elements of `self` with the listed indices
+template <typename Self, std::size_t... Js> struct _pack_from_select final {
+  Self &&self;
+
+  template <std::size_t I> static constexpr std::size_t _index = [] {
+    constexpr std::size_t indices[] = {Js...};
+    return indices[I];
+  }();
+
+  template <std::size_t I, typename T>
+  static constexpr bool _is_nothrow = std::is_nothrow_constructible_v<
+      T, decltype(std::remove_cvref_t<Self>::template _get<_index<I>>(std::declval<Self>()))>;
+
+  template <std::size_t I, typename T>
+  constexpr auto operator()(std::type_identity<_element<I, T>>) noexcept(_is_nothrow<I, T>) -> T
+  {
+    return std::remove_cvref_t<Self>::template _get<_index<I>>(FWD(self));
+  }
+};
+
+// NOTE Elements of an rvalue are moved to the selection, so each can be selected only once
+template <std::size_t... Js> constexpr bool _pack_distinct = [] {
+  constexpr std::size_t indices[] = {Js..., 0};
+  for (std::size_t i = 0; i < sizeof...(Js); ++i) {
+    for (std::size_t j = i + 1; j < sizeof...(Js); ++j) {
+      if (indices[i] == indices[j])
+        return false;
+    }
+  }
+  return true;
+}();
+
+// NOTE Element of a view of a pack, which refers to the element of an lvalue or holds the element moved from an rvalue
+template <typename T>
+using _pack_view_t = std::conditional_t<std::is_rvalue_reference_v<T>, std::remove_reference_t<T>, T>;
+
+// NOTE Builds pack `P` in place, with elements initialized by `fn` as in `_pack_storage::_make`
+template <typename P, typename Fn>
+[[nodiscard]] constexpr auto _pack_make(Fn &&fn) noexcept(noexcept(P::_storage::_make(FWD(fn)))) -> P
+{
+  if constexpr (P::_reordered)
+    return P(_pack_init_tag{}, FWD(fn));
+  else
+    return P{P::_storage::_make(FWD(fn))};
+}
+
 template <typename, typename... Ts> struct pack_impl;
 
-template <std::size_t... Is, typename... Ts> struct pack_impl<std::index_sequence<Is...>, Ts...> : _element<Is, Ts>... {
+// NOTE Elements are always accessed as `_element<I, T>::v` with logical index `I`, regardless of their layout
+template <std::size_t... Is, typename... Ts>
+struct pack_impl<std::index_sequence<Is...>, Ts...> : _pack_layout<std::index_sequence<Is...>, Ts...>::type {
   static constexpr std::size_t size = sizeof...(Is);
+  static constexpr bool _reordered = _pack_layout<std::index_sequence<Is...>, Ts...>::reordered;
+  using _storage = typename _pack_layout<std::index_sequence<Is...>, Ts...>::type;
 
   template <typename Self, typename Fn, typename... Args>
-  static constexpr auto _invoke(Self &&self, Fn &&fn, Args &&...args) noexcept
+  static constexpr auto _invoke(Self &&self, Fn &&fn, Args &&...args) noexcept(
+      _is_nothrow_invocable_v<decltype(fn), decltype(args)..., apply_const_lvalue_t<Self, Ts &&>...>)
       -> _invoke_result_t<decltype(fn), decltype(args)..., apply_const_lvalue_t<Self, Ts &&>...>
   {
     return ::fn::detail::_invoke(FWD(fn), FWD(args)...,
@@ -34,11 +191,271 @@ template <std::size_t... Is, typename... Ts> struct pack_impl<std::index_sequenc
   }
 
   template <typename T, typename Self>
-  static constexpr auto _append(Self &&self, auto &&...args) noexcept
-      -> pack_impl<std::index_sequence<Is..., size>, Ts..., T>
+  static constexpr auto _append(Self &&self, auto &&...args) noexcept(
+      noexcept(_pack_make<::fn::pack<Ts..., T>>(std::declval<_pack_from_append<Self, decltype(args)...>>())))
+      -> ::fn::pack<Ts..., T>
+    requires std::is_constructible_v<T, decltype(args)...>
+  {
+    using type = _pack_from_append<Self, decltype(args)...>;
+    return _pack_make<::fn::pack<Ts..., T>>(type{FWD(self), {FWD(args)...}});
+  }
+
+  template <std::size_t I, typename Self>
+  [[nodiscard]] static constexpr auto _get(Self &&self) noexcept
+      -> apply_const_lvalue_t<Self, select_nth_t<I, Ts...> &&>
+  {
+    using type = select_nth_t<I, Ts...>;
+    return static_cast<apply_const_lvalue_t<Self, type &&>>(FWD(self)._element<I, type>::v);
+  }
+
+  template <std::size_t... Js, typename Self>
+  static constexpr auto _select(Self &&self) noexcept(noexcept(
+      _pack_make<::fn::pack<_pack_view_t<apply_const_lvalue_t<Self, select_nth_t<Js, Ts...> &&>>...>>(
+          std::declval<_pack_from_select<Self, Js...>>())))
+      -> ::fn::pack<_pack_view_t<apply_const_lvalue_t<Self, select_nth_t<Js, Ts...> &&>>...>
+  {
+    using type = ::fn::pack<_pack_view_t<apply_const_lvalue_t<Self, select_nth_t<Js, Ts...> &&>>...>;
+    return _pack_make<type>(_pack_from_select<Self, Js...>{FWD(self)});
+  }
+
+  template <std::size_t B, std::size_t... Ks, typename Self>
+  static constexpr auto _slice(Self &&self, std::index_sequence<Ks...>) noexcept(
+      noexcept(_select<(B + Ks)...>(FWD(self)))) -> decltype(auto)
+  {
+    return _select<(B + Ks)...>(FWD(self));
+  }
+
+  // NOTE Index of the only element of type `T`, or `size` if there is none or more than one
+  template <typename T> static constexpr std::size_t _index_of = [] {
+    constexpr bool same[] = {std::is_same_v<T, Ts>..., false};
+    std::size_t result = size;
+    for (std::size_t i = 0; i < size; ++i) {
+      if (same[i])
+        result = result == size ? i : size + 1;
+    }
+    return result < size ? result : size;
+  }();
+
+  template <typename T>
+  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) & noexcept(
+      noexcept(_append<T>(*this, FWD(args)...))) -> ::fn::pack<Ts..., T>
     requires std::is_constructible_v<T, decltype(args)...>
+             && requires { _append<T>(*this, FWD(args)...); }
+  {
+    return _append<T>(*this, FWD(args)...);
+  }
+
+  template <typename T>
+  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) const & noexcept(
+      noexcept(_append<T>(*this, FWD(args)...))) -> ::fn::pack<Ts..., T>
+    requires std::is_constructible_v<T, decltype(args)...>
+             && requires { _append<T>(*this, FWD(args)...); }
+  {
+    return _append<T>(*this, FWD(args)...);
+  }
+
+  template <typename T>
+  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) && noexcept(
+      noexcept(_append<T>(std::move(*this), FWD(args)...))) -> ::fn::pack<Ts..., T>
+    requires std::is_constructible_v<T, decltype(args)...>
+             && requires { _append<T>(std::move(*this), FWD(args)...); }
+  {
+    return _append<T>(std::move(*this), FWD(args)...);
+  }
+
+  template <typename T>
+  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) const && noexcept(
+      noexcept(_append<T>(std::move(*this), FWD(args)...))) -> ::fn::pack<Ts..., T>
+    requires std::is_constructible_v<T, decltype(args)...>
+             && requires { _append<T>(std::move(*this), FWD(args)...); }
+  {
+    return _append<T>(std::move(*this), FWD(args)...);
+  }
+
+  template <typename Arg>
+  [[nodiscard]] constexpr auto append(Arg &&arg) & noexcept(noexcept(_append<Arg>(*this, FWD(arg))))
+      -> ::fn::pack<Ts..., Arg>
+    requires requires { _append<Arg>(*this, FWD(arg)); }
+  {
+    return _append<Arg>(*this, FWD(arg));
+  }
+
+  template <typename Arg>
+  [[nodiscard]] constexpr auto append(Arg &&arg) const & noexcept(noexcept(_append<Arg>(*this, FWD(arg))))
+      -> ::fn::pack<Ts..., Arg>
+    requires requires { _append<Arg>(*this, FWD(arg)); }
+  {
+    return _append<Arg>(*this, FWD(arg));
+  }
+
+  template <typename Arg>
+  [[nodiscard]] constexpr auto append(Arg &&arg) && noexcept(noexcept(_append<Arg>(std::move(*this), FWD(arg))))
+      -> ::fn::pack<Ts..., Arg>
+    requires requires { _append<Arg>(std::move(*this), FWD(arg)); }
+  {
+    return _append<Arg>(std::move(*this), FWD(arg));
+  }
+
+  template <typename Arg>
+  [[nodiscard]] constexpr auto append(Arg &&arg) const && noexcept(noexcept(_append<Arg>(std::move(*this), FWD(arg))))
+      -> ::fn::pack<Ts..., Arg>
+    requires requires { _append<Arg>(std::move(*this), FWD(arg)); }
+  {
+    return _append<Arg>(std::move(*this), FWD(arg));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) & noexcept(
+      noexcept(_invoke(*this, FWD(fn), FWD(args)...))) -> decltype(auto)
+    requires requires { _invoke(*this, FWD(fn), FWD(args)...); }
+  {
+    return _invoke(*this, FWD(fn), FWD(args)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) const & noexcept(
+      noexcept(_invoke(*this, FWD(fn), FWD(args)...))) -> decltype(auto)
+    requires requires { _invoke(*this, FWD(fn), FWD(args)...); }
+  {
+    return _invoke(*this, FWD(fn), FWD(args)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) && noexcept(
+      noexcept(_invoke(std::move(*this), FWD(fn), FWD(args)...))) -> decltype(auto)
+    requires requires { _invoke(std::move(*this), FWD(fn), FWD(args)...); }
+  {
+    return _invoke(std::move(*this), FWD(fn), FWD(args)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) const && noexcept(
+      noexcept(_invoke(std::move(*this), FWD(fn), FWD(args)...))) -> decltype(auto)
+    requires requires { _invoke(std::move(*this), FWD(fn), FWD(args)...); }
+  {
+    return _invoke(std::move(*this), FWD(fn), FWD(args)...);
+  }
+
+  // NOTE Pack of the elements with the listed indices, in the listed order. Elements of an lvalue are not copied, the
+  // result refers to them (with const added as in `invoke`). Elements of an rvalue are moved, unless references, and
+  // each can be selected only once. `slice<B, E>` selects the elements in range [B, E), and `project<Us...>` the only
+  // elements of types `Us...`
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size))
+  [[nodiscard]] constexpr auto select() & noexcept(noexcept(_select<Js...>(*this)))
+  {
+    return _select<Js...>(*this);
+  }
+
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size))
+  [[nodiscard]] constexpr auto select() const & noexcept(noexcept(_select<Js...>(*this)))
+  {
+    return _select<Js...>(*this);
+  }
+
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size)) && _pack_distinct<Js...>
+  [[nodiscard]] constexpr auto select() && noexcept(noexcept(_select<Js...>(std::move(*this))))
+  {
+    return _select<Js...>(std::move(*this));
+  }
+
+  // NOTE Otherwise the `const &` overload would be selected, yielding references to the elements of an rvalue
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size)) && (not _pack_distinct<Js...>)
+  constexpr auto select() && = delete;
+
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size)) && _pack_distinct<Js...>
+  [[nodiscard]] constexpr auto select() const && noexcept(noexcept(_select<Js...>(std::move(*this))))
+  {
+    return _select<Js...>(std::move(*this));
+  }
+
+  template <std::size_t... Js>
+    requires(sizeof...(Js) > 0) && (... && (Js < size)) && (not _pack_distinct<Js...>)
+  constexpr auto select() const && = delete;
+
+  template <std::size_t B, std::size_t E>
+    requires(B < E) && (E <= size)
+  [[nodiscard]] constexpr auto slice() & noexcept(
+      noexcept(_slice<B>(*this, std::make_index_sequence<E - B>{})))
+  {
+    return _slice<B>(*this, std::make_index_sequence<E - B>{});
+  }
+
+  template <std::size_t B, std::size_t E>
+    requires(B < E) && (E <= size)
+  [[nodiscard]] constexpr auto slice() const & noexcept(
+      noexcept(_slice<B>(*this, std::make_index_sequence<E - B>{})))
+  {
+    return _slice<B>(*this, std::make_index_sequence<E - B>{});
+  }
+
+  template <std::size_t B, std::size_t E>
+    requires(B < E) && (E <= size)
+  [[nodiscard]] constexpr auto slice() && noexcept(
+      noexcept(_slice<B>(std::move(*this), std::make_index_sequence<E - B>{})))
+  {
+    return _slice<B>(std::move(*this), std::make_index_sequence<E - B>{});
+  }
+
+  template <std::size_t B, std::size_t E>
+    requires(B < E) && (E <= size)
+  [[nodiscard]] constexpr auto slice() const && noexcept(
+      noexcept(_slice<B>(std::move(*this), std::make_index_sequence<E - B>{})))
+  {
+    return _slice<B>(std::move(*this), std::make_index_sequence<E - B>{});
+  }
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size))
+  [[nodiscard]] constexpr auto project() & noexcept(noexcept(_select<_index_of<Us>...>(*this)))
+  {
+    return _select<_index_of<Us>...>(*this);
+  }
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size))
+  [[nodiscard]] constexpr auto project() const & noexcept(noexcept(_select<_index_of<Us>...>(*this)))
+  {
+    return _select<_index_of<Us>...>(*this);
+  }
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size)) && _pack_distinct<_index_of<Us>...>
+  [[nodiscard]] constexpr auto project() && noexcept(noexcept(_select<_index_of<Us>...>(std::move(*this))))
+  {
+    return _select<_index_of<Us>...>(std::move(*this));
+  }
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size)) && (not _pack_distinct<_index_of<Us>...>)
+  constexpr auto project() && = delete;
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size)) && _pack_distinct<_index_of<Us>...>
+  [[nodiscard]] constexpr auto project() const && noexcept(noexcept(_select<_index_of<Us>...>(std::move(*this))))
+  {
+    return _select<_index_of<Us>...>(std::move(*this));
+  }
+
+  template <typename... Us>
+    requires(sizeof...(Us) > 0) && (... && (_index_of<Us> < size)) && (not _pack_distinct<_index_of<Us>...>)
+  constexpr auto project() const && = delete;
+
+  static constexpr bool _equal(pack_impl const &lh, pack_impl const &rh) noexcept
+  {
+    return (true && ... && (lh._element<Is, Ts>::v == rh._element<Is, Ts>::v));
+  }
+
+  // NOTE Lexicographic, stops at the first element which does not compare equivalent
+  template <typename R> static constexpr auto _compare(pack_impl const &lh, pack_impl const &rh) noexcept -> R
   {
-    return {static_cast<apply_const_lvalue_t<Self, Ts &&>>(FWD(self)._element<Is, Ts>::v)..., T{FWD(args)...}};
+    R result = R::equivalent;
+    (void)(true && ... && ((result = lh._element<Is, Ts>::v <=> rh._element<Is, Ts>::v) == 0));
+    return result;
   }
 };
 
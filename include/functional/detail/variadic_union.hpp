@@ -8,6 +8,8 @@
 
 #include "functional/detail/functional.hpp"
 #include "functional/detail/fwd_macro.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/detail/traits.hpp"
 
 #include <concepts>
 #include <cstdint>
@@ -38,6 +40,9 @@ template <typename T0> union variadic_union<T0> final {
       = std::is_same_v<T, T0>;
   static constexpr std::size_t size = 1;
 
+  constexpr ~variadic_union()
+    requires(std::is_trivially_destructible_v<T0>)
+  = default;
   constexpr ~variadic_union() {}
 };
 
@@ -54,6 +59,9 @@ template <typename T0, typename T1> union variadic_union<T0, T1> final {
       = std::is_same_v<T, T0> || std::is_same_v<T, T1>;
   static constexpr std::size_t size = 2;
 
+  constexpr ~variadic_union()
+    requires(std::is_trivially_destructible_v<T0> && std::is_trivially_destructible_v<T1>)
+  = default;
   constexpr ~variadic_union() {}
 };
 
@@ -74,6 +82,10 @@ template <typename T0, typename T1, typename T2> union variadic_union<T0, T1, T2
       = std::is_same_v<T, T0> || std::is_same_v<T, T1> || std::is_same_v<T, T2>;
   static constexpr std::size_t size = 3;
 
+  constexpr ~variadic_union()
+    requires(std::is_trivially_destructible_v<T0> && std::is_trivially_destructible_v<T1>
+           && std::is_trivially_destructible_v<T2>)
+  = default;
   constexpr ~variadic_union() {}
 };
 
@@ -99,28 +111,29 @@ template <typename T0, typename T1, typename T2, typename T3> union variadic_uni
       = std::is_same_v<T, T0> || std::is_same_v<T, T1> || std::is_same_v<T, T2> || std::is_same_v<T, T3>;
   static constexpr std::size_t size = 4;
 
+  constexpr ~variadic_union()
+    requires(std::is_trivially_destructible_v<T0> && std::is_trivially_destructible_v<T1>
+           && std::is_trivially_destructible_v<T2> && std::is_trivially_destructible_v<T3>)
+  = default;
   constexpr ~variadic_union() {}
 };
 
+template <typename... Ts> struct _variadic_union_more;
+
+// NOTE Union of more than 4 alternatives holds the first 4 directly and the remaining ones in `more`. If there are
+// more than 4 remaining, these are split in two halves to keep the depth of nesting logarithmic in the number of
+// alternatives. Alternatives are accessed by their position, see _ptr_variadic_union_nth and _make_variadic_union_nth
 template <typename T0, typename T1, typename T2, typename T3, typename... Ts>
   requires(sizeof...(Ts) > 0)
 union variadic_union<T0, T1, T2, T3, Ts...> final {
-  static_assert(not std::is_same_v<T0, T1>);
-  static_assert(not std::is_same_v<T0, T2>);
-  static_assert(not std::is_same_v<T1, T2>);
-  static_assert(not std::is_same_v<T0, T3>);
-  static_assert(not std::is_same_v<T1, T3>);
-  static_assert(not std::is_same_v<T2, T3>);
-  static_assert(not(... || std::is_same_v<T0, Ts>));
-  static_assert(not(... || std::is_same_v<T1, Ts>));
-  static_assert(not(... || std::is_same_v<T2, Ts>));
-  static_assert(not(... || std::is_same_v<T3, Ts>));
+  // NOTE Duplicate alternatives are diagnosed in linear time, as duplicate base classes of _indexed_type_list
+  static_assert(sizeof(_indexed_type_list<T0, T1, T2, T3, Ts...>) > 0);
 
   using t0 = T0;
   using t1 = T1;
   using t2 = T2;
   using t3 = T3;
-  using more_t = variadic_union<Ts...>;
+  using more_t = _variadic_union_more<Ts...>::type;
   T0 v0;
   T1 v1;
   T2 v2;
@@ -129,90 +142,141 @@ union variadic_union<T0, T1, T2, T3, Ts...> final {
 
   template <typename T>
   static constexpr bool has_type //
-      = std::is_same_v<T, T0> || std::is_same_v<T, T1> || std::is_same_v<T, T2> || std::is_same_v<T, T3>
-        || variadic_union<Ts...>::template has_type<T>;
-  static constexpr std::size_t size = 4 + more_t::size;
-
+      = type_one_of<T, T0, T1, T2, T3, Ts...>;
+  static constexpr std::size_t size = 4 + sizeof...(Ts);
+
+  constexpr ~variadic_union()
+    requires(std::is_trivially_destructible_v<T0> && std::is_trivially_destructible_v<T1>
+           && std::is_trivially_destructible_v<T2> && std::is_trivially_destructible_v<T3>
+           && std::is_trivially_destructible_v<more_t>)
+  = default;
   constexpr ~variadic_union() {}
 };
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
-  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>
-           && (U::template has_type<T>) && std::is_same_v<T, typename U::t0>
-{
-  return &v.v0;
-}
+template <typename Lo, typename Hi> union _variadic_union_node final {
+  using lo_t = Lo;
+  using hi_t = Hi;
+  Lo lo;
+  Hi hi;
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
-  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>
-           && (U::template has_type<T>) && std::is_same_v<T, typename U::t1>
-{
-  return &v.v1;
-}
+  static constexpr std::size_t size = Lo::size + Hi::size;
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
-  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>
-           && (U::template has_type<T>) && std::is_same_v<T, typename U::t2>
-{
-  return &v.v2;
-}
+  constexpr ~_variadic_union_node()
+    requires(std::is_trivially_destructible_v<Lo> && std::is_trivially_destructible_v<Hi>)
+  = default;
+  constexpr ~_variadic_union_node() {}
+};
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
-  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>
-           && (U::template has_type<T>) && std::is_same_v<T, typename U::t3>
-{
-  return &v.v3;
-}
+template <typename T> constexpr bool _is_variadic_union_node = false;
+template <typename Lo, typename Hi> constexpr bool _is_variadic_union_node<_variadic_union_node<Lo, Hi>> = true;
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
-  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>
-           && (U::template has_type<T>) && (U::more_t::template has_type<T>)
+template <typename... Ts> struct _variadic_union_list;
+template <std::size_t N, typename Lo, typename... Ts> struct _variadic_union_split;
+template <typename... Lo, typename... Ts> struct _variadic_union_split<0, _variadic_union_list<Lo...>, Ts...> {
+  using type = _variadic_union_node<variadic_union<Lo...>, variadic_union<Ts...>>;
+};
+template <std::size_t N, typename... Lo, typename T, typename... Ts>
+  requires(N > 0)
+struct _variadic_union_split<N, _variadic_union_list<Lo...>, T, Ts...>
+    : _variadic_union_split<N - 1, _variadic_union_list<Lo..., T>, Ts...> {};
+
+template <typename... Ts> struct _variadic_union_more {
+  using type = variadic_union<Ts...>;
+};
+template <typename... Ts>
+  requires(sizeof...(Ts) > 4)
+struct _variadic_union_more<Ts...> {
+  using type = _variadic_union_split<sizeof...(Ts) / 2, _variadic_union_list<>, Ts...>::type;
+};
+
+template <typename U> struct _variadic_union_index;
+template <typename... Ts> struct _variadic_union_index<variadic_union<Ts...>> final {
+  template <typename T> static constexpr std::size_t value = type_index<T, Ts...>;
+};
+
+template <std::size_t I>
+[[nodiscard]] constexpr auto *_ptr_variadic_union_nth(auto &&v) noexcept
 {
-  return ptr_variadic_union<T, typename U::more_t>(v.more);
+  using U = std::remove_cvref_t<decltype(v)>;
+  if constexpr (_is_variadic_union_node<U>) {
+    if constexpr (I < U::lo_t::size)
+      return _ptr_variadic_union_nth<I>(v.lo);
+    else
+      return _ptr_variadic_union_nth<I - U::lo_t::size>(v.hi);
+  } else if constexpr (I == 0)
+    return &v.v0;
+  else if constexpr (I == 1)
+    return &v.v1;
+  else if constexpr (I == 2)
+    return &v.v2;
+  else if constexpr (I == 3)
+    return &v.v3;
+  else
+    return _ptr_variadic_union_nth<I - 4>(v.more);
 }
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto make_variadic_union(auto &&...args)
-  requires(U::template has_type<T>) && std::is_same_v<T, typename U::t0>
+template <std::size_t I, typename U> [[nodiscard]] constexpr auto _make_variadic_union_nth(auto &&...args) -> U
 {
-  return U{.v0 = T{FWD(args)...}};
+  if constexpr (_is_variadic_union_node<U>) {
+    if constexpr (I < U::lo_t::size)
+      return U{.lo = _make_variadic_union_nth<I, typename U::lo_t>(FWD(args)...)};
+    else
+      return U{.hi = _make_variadic_union_nth<I - U::lo_t::size, typename U::hi_t>(FWD(args)...)};
+  } else if constexpr (I == 0)
+    return U{.v0 = typename U::t0{FWD(args)...}};
+  else if constexpr (I == 1)
+    return U{.v1 = typename U::t1{FWD(args)...}};
+  else if constexpr (I == 2)
+    return U{.v2 = typename U::t2{FWD(args)...}};
+  else if constexpr (I == 3)
+    return U{.v3 = typename U::t3{FWD(args)...}};
+  else
+    return U{.more = _make_variadic_union_nth<I - 4, typename U::more_t>(FWD(args)...)};
 }
 
 template <typename T, typename U>
-[[nodiscard]] constexpr auto make_variadic_union(auto &&...args)
-  requires(U::template has_type<T>) && std::is_same_v<T, typename U::t1>
+[[nodiscard]] constexpr auto *ptr_variadic_union(some_variadic_union auto &&v) noexcept
+  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> && (U::template has_type<T>)
 {
-  return U{.v1 = T{FWD(args)...}};
+  return _ptr_variadic_union_nth<_variadic_union_index<U>::template value<T>>(v);
 }
 
 template <typename T, typename U>
-[[nodiscard]] constexpr auto make_variadic_union(auto &&...args)
-  requires(U::template has_type<T>) && std::is_same_v<T, typename U::t2>
+[[nodiscard]] constexpr auto make_variadic_union(auto &&...args) -> U
+  requires(U::template has_type<T>)
 {
-  return U{.v2 = T{FWD(args)...}};
+  return _make_variadic_union_nth<_variadic_union_index<U>::template value<T>, U>(FWD(args)...);
 }
 
-template <typename T, typename U>
-[[nodiscard]] constexpr auto make_variadic_union(auto &&...args)
-  requires(U::template has_type<T>) && std::is_same_v<T, typename U::t3>
+template <std::size_t I, typename U> struct _variadic_union_nth;
+template <std::size_t I, typename... Ts> struct _variadic_union_nth<I, variadic_union<Ts...>> final {
+  using type = select_nth_t<I, Ts...>;
+};
+
+template <std::size_t I, typename R, typename U, bool Typed, typename V, typename Fn>
+constexpr auto _invoke_variadic_union_nth(V &&v, Fn &&fn) -> R
 {
-  return U{.v3 = T{FWD(args)...}};
+  using T = _variadic_union_nth<I, U>::type;
+  if constexpr (Typed)
+    return static_cast<R>(_invoke(FWD(fn), std::in_place_type<T>,
+                                  static_cast<apply_const_lvalue_t<V, T &&>>(*_ptr_variadic_union_nth<I>(v))));
+  else
+    return static_cast<R>(_invoke(FWD(fn), static_cast<apply_const_lvalue_t<V, T &&>>(*_ptr_variadic_union_nth<I>(v))));
 }
 
-template <typename T, typename U>
-[[nodiscard]] constexpr U make_variadic_union(auto &&...args)
-  requires(U::template has_type<T>) && (U::more_t::template has_type<T>)
+// NOTE Tail of the chain of comparisons for unions of more than 4 alternatives, not recursing into `more`
+template <std::size_t I, typename R, typename U, bool Typed, typename V, typename Fn>
+constexpr auto _invoke_variadic_union_chain_nth(V &&v, std::size_t index, Fn &&fn) -> R
 {
-  return U{.more = make_variadic_union<T, typename U::more_t>(FWD(args)...)};
+  if constexpr (I + 1 < U::size) {
+    if (index != I)
+      return _invoke_variadic_union_chain_nth<I + 1, R, U, Typed>(FWD(v), index, FWD(fn));
+  }
+  return _invoke_variadic_union_nth<I, R, U, Typed>(FWD(v), FWD(fn));
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                                  //
            && _typelist_invocable_r<R, Fn, decltype(v)> && (not _typelist_type_invocable_r<R, Fn, decltype(v)>) //
            && (U::size == 1) && (not std::is_same_v<void, R>)
@@ -223,7 +287,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable_r<R, Fn, decltype(v)>   //
            && (U::size == 1) && (not std::is_same_v<void, R>)
@@ -234,7 +298,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                        //
            && _typelist_invocable<Fn, decltype(v)> && (not _typelist_type_invocable<Fn, decltype(v)>) //
            && (U::size == 1) && (std::is_same_v<void, R>)
@@ -245,7 +309,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable<Fn, decltype(v)>        //
            && (U::size == 1) && (std::is_same_v<void, R>)
@@ -256,7 +320,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                                  //
            && _typelist_invocable_r<R, Fn, decltype(v)> && (not _typelist_type_invocable_r<R, Fn, decltype(v)>) //
            && (U::size == 2) && (not std::is_same_v<void, R>)
@@ -269,7 +333,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable_r<R, Fn, decltype(v)>   //
            && (U::size == 2) && (not std::is_same_v<void, R>)
@@ -282,7 +346,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                        //
            && _typelist_invocable<Fn, decltype(v)> && (not _typelist_type_invocable<Fn, decltype(v)>) //
            && (U::size == 2) && (std::is_same_v<void, R>)
@@ -295,7 +359,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable<Fn, decltype(v)>        //
            && (U::size == 2) && (std::is_same_v<void, R>)
@@ -308,7 +372,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                                  //
            && _typelist_invocable_r<R, Fn, decltype(v)> && (not _typelist_type_invocable_r<R, Fn, decltype(v)>) //
            && (U::size == 3) && (not std::is_same_v<void, R>)
@@ -323,7 +387,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable_r<R, Fn, decltype(v)>   //
            && (U::size == 3) && (not std::is_same_v<void, R>)
@@ -338,7 +402,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                        //
            && _typelist_invocable<Fn, decltype(v)> && (not _typelist_type_invocable<Fn, decltype(v)>) //
            && (U::size == 3) && (std::is_same_v<void, R>)
@@ -353,7 +417,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable<Fn, decltype(v)>        //
            && (U::size == 3) && (std::is_same_v<void, R>)
@@ -368,7 +432,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                                  //
            && _typelist_invocable_r<R, Fn, decltype(v)> && (not _typelist_type_invocable_r<R, Fn, decltype(v)>) //
            && (U::size == 4) && (not std::is_same_v<void, R>)
@@ -385,7 +449,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable_r<R, Fn, decltype(v)>   //
            && (U::size == 4) && (not std::is_same_v<void, R>)
@@ -402,7 +466,7 @@ template <typename R, typename U, typename Fn>
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                        //
            && _typelist_invocable<Fn, decltype(v)> && (not _typelist_type_invocable<Fn, decltype(v)>) //
            && (U::size == 4) && (std::is_same_v<void, R>)
@@ -419,7 +483,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable<Fn, decltype(v)>        //
            && (U::size == 4) && (std::is_same_v<void, R>)
@@ -436,7 +500,7 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                                  //
            && _typelist_invocable_r<R, Fn, decltype(v)> && (not _typelist_type_invocable_r<R, Fn, decltype(v)>) //
            && (U::size > 4) && (not std::is_same_v<void, R>)
@@ -450,11 +514,11 @@ template <typename R, typename U, typename Fn>
   else if (index == 3)
     return static_cast<R>(_invoke(FWD(fn), FWD(v).v3));
   else
-    return invoke_variadic_union<R, typename U::more_t>(FWD(v).more, index - 4, FWD(fn));
+    return _invoke_variadic_union_chain_nth<4, R, U, false>(FWD(v), index, FWD(fn));
 }
 
 template <typename R, typename U, typename Fn>
-[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+[[nodiscard]] constexpr auto _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable_r<R, Fn, decltype(v)>   //
            && (U::size > 4) && (not std::is_same_v<void, R>)
@@ -468,11 +532,11 @@ template <typename R, typename U, typename Fn>
   else if (index == 3)
     return static_cast<R>(_invoke(FWD(fn), std::in_place_type<typename U::t3>, FWD(v).v3));
   else
-    return invoke_variadic_union<R, typename U::more_t>(FWD(v).more, index - 4, FWD(fn));
+    return _invoke_variadic_union_chain_nth<4, R, U, true>(FWD(v), index, FWD(fn));
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                        //
            && _typelist_invocable<Fn, decltype(v)> && (not _typelist_type_invocable<Fn, decltype(v)>) //
            && (U::size > 4) && (std::is_same_v<void, R>)
@@ -486,11 +550,11 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
   else if (index == 3)
     return (void)_invoke(FWD(fn), FWD(v).v3);
   else
-    return invoke_variadic_union<R, typename U::more_t>(FWD(v).more, index - 4, FWD(fn));
+    return _invoke_variadic_union_chain_nth<4, R, U, false>(FWD(v), index, FWD(fn));
 }
 
 template <typename R, typename U, typename Fn>
-constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+constexpr void _invoke_variadic_union_chain(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
   requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U> //
            && _typelist_type_invocable<Fn, decltype(v)>        //
            && (U::size > 4) && (std::is_same_v<void, R>)
@@ -504,7 +568,52 @@ constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t i
   else if (index == 3)
     return (void)_invoke(FWD(fn), std::in_place_type<typename U::t3>, FWD(v).v3);
   else
-    return invoke_variadic_union<R, typename U::more_t>(FWD(v).more, index - 4, FWD(fn));
+    return _invoke_variadic_union_chain_nth<4, R, U, true>(FWD(v), index, FWD(fn));
+}
+
+template <typename R, typename U, bool Typed, typename V, typename Fn, typename = std::make_index_sequence<U::size>>
+struct _invoke_variadic_union_table;
+template <typename R, typename U, bool Typed, typename V, typename Fn, std::size_t... Is>
+struct _invoke_variadic_union_table<R, U, Typed, V, Fn, std::index_sequence<Is...>> final {
+  static constexpr R (*value[])(V &&, Fn &&) = {&_invoke_variadic_union_nth<Is, R, U, Typed, V, Fn>...};
+};
+
+// NOTE Dispatch of invoke_variadic_union. The chain of comparisons is cheap for small unions and can be
+// fully inlined, while the table of function pointers takes constant time regardless of the size of union.
+struct _invoke_chain_tag final {};
+struct _invoke_table_tag final {};
+
+constexpr inline std::size_t _invoke_table_threshold = 16;
+template <typename U>
+using _invoke_select_tag
+    = std::conditional_t<(U::size > _invoke_table_threshold), _invoke_table_tag, _invoke_chain_tag>;
+
+template <typename R, typename U, typename Tag = _invoke_select_tag<U>, typename Fn>
+[[nodiscard]] constexpr auto invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                               //
+           && (_typelist_invocable_r<R, Fn, decltype(v)> || _typelist_type_invocable_r<R, Fn, decltype(v)>) //
+           && (not std::is_same_v<void, R>)
+{
+  if constexpr (std::is_same_v<Tag, _invoke_table_tag>) {
+    constexpr bool typed = _typelist_type_invocable_r<R, Fn, decltype(v)>;
+    using table = _invoke_variadic_union_table<R, U, typed, decltype(v), Fn>;
+    return table::value[index](FWD(v), FWD(fn));
+  } else
+    return _invoke_variadic_union_chain<R, U>(FWD(v), index, FWD(fn));
+}
+
+template <typename R, typename U, typename Tag = _invoke_select_tag<U>, typename Fn>
+constexpr void invoke_variadic_union(some_variadic_union auto &&v, std::size_t index, Fn &&fn)
+  requires std::is_same_v<std::remove_cvref_t<decltype(v)>, U>                                 //
+           && (_typelist_invocable<Fn, decltype(v)> || _typelist_type_invocable<Fn, decltype(v)>) //
+           && (std::is_same_v<void, R>)
+{
+  if constexpr (std::is_same_v<Tag, _invoke_table_tag>) {
+    constexpr bool typed = _typelist_type_invocable<Fn, decltype(v)>;
+    using table = _invoke_variadic_union_table<R, U, typed, decltype(v), Fn>;
+    return table::value[index](FWD(v), FWD(fn));
+  } else
+    return _invoke_variadic_union_chain<R, U>(FWD(v), index, FWD(fn));
 }
 
 } // namespace fn::detail
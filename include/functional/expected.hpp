@@ -6,6 +6,7 @@
 #ifndef INCLUDE_FUNCTIONAL_EXPECTED
 #define INCLUDE_FUNCTIONAL_EXPECTED
 
+#include "functional/detail/pack_expr.hpp"
 #include "functional/functional.hpp"
 #include "functional/fwd.hpp"
 #include "functional/pack.hpp"
@@ -58,9 +59,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::error_type, error_type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), this->value());
+      return ::fn::detail::_invoke(FWD(fn), **this);
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -71,9 +72,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::error_type, error_type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), this->value());
+      return ::fn::detail::_invoke(FWD(fn), **this);
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -84,9 +85,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::error_type, error_type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+      return ::fn::detail::_invoke(FWD(fn), std::move(**this));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -97,9 +98,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::error_type, error_type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+      return ::fn::detail::_invoke(FWD(fn), std::move(**this));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   // and_then void
@@ -113,7 +114,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return ::fn::detail::_invoke(FWD(fn));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -126,7 +127,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return ::fn::detail::_invoke(FWD(fn));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -139,7 +140,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return ::fn::detail::_invoke(FWD(fn));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -152,7 +153,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return ::fn::detail::_invoke(FWD(fn));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   // or_else not void
@@ -164,9 +165,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::value_type, value_type>);
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
-      return ::fn::detail::_invoke(FWD(fn), this->error());
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), this->error()); });
   }
 
   template <typename Fn>
@@ -177,9 +178,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::value_type, value_type>);
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
-      return ::fn::detail::_invoke(FWD(fn), this->error());
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), this->error()); });
   }
 
   template <typename Fn>
@@ -190,9 +191,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::value_type, value_type>);
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -203,9 +204,9 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     static_assert(some_expected<type>);
     static_assert(std::is_same_v<typename type::value_type, value_type>);
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), std::move(this->error())); });
   }
 
   // or_else void
@@ -219,7 +220,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return ::fn::detail::_invoke(FWD(fn), this->error());
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), this->error()); });
   }
 
   template <typename Fn>
@@ -232,7 +233,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return ::fn::detail::_invoke(FWD(fn), this->error());
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), this->error()); });
   }
 
   template <typename Fn>
@@ -245,7 +246,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -258,7 +259,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return ::fn::detail::_invoke(FWD(fn), std::move(this->error())); });
   }
 
   // transform not void
@@ -269,12 +270,12 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using type = expected<value_type, Err>;
     if (this->has_value())
       if constexpr (std::same_as<value_type, void>) {
-        ::fn::detail::_invoke(FWD(fn), this->value());
+        ::fn::detail::_invoke(FWD(fn), **this);
         return type();
       } else
-        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), this->value()));
+        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), **this));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -285,12 +286,12 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using type = expected<value_type, Err>;
     if (this->has_value())
       if constexpr (std::same_as<value_type, void>) {
-        ::fn::detail::_invoke(FWD(fn), this->value());
+        ::fn::detail::_invoke(FWD(fn), **this);
         return type();
       } else
-        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), this->value()));
+        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), **this));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -300,12 +301,12 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using type = expected<value_type, Err>;
     if (this->has_value())
       if constexpr (std::same_as<value_type, void>) {
-        ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+        ::fn::detail::_invoke(FWD(fn), std::move(**this));
         return type();
       } else
-        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(this->value())));
+        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(**this)));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -316,12 +317,12 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using type = expected<value_type, Err>;
     if (this->has_value())
       if constexpr (std::same_as<value_type, void>) {
-        ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+        ::fn::detail::_invoke(FWD(fn), std::move(**this));
         return type();
       } else
-        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(this->value())));
+        return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(**this)));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   // transform void
@@ -338,7 +339,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
       } else
         return type(std::in_place, ::fn::detail::_invoke(FWD(fn)));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -354,7 +355,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
       } else
         return type(std::in_place, ::fn::detail::_invoke(FWD(fn)));
     else
-      return type(std::unexpect, this->error());
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, this->error()); });
   }
 
   template <typename Fn>
@@ -370,7 +371,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
       } else
         return type(std::in_place, ::fn::detail::_invoke(FWD(fn)));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   template <typename Fn>
@@ -386,7 +387,7 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
       } else
         return type(std::in_place, ::fn::detail::_invoke(FWD(fn)));
     else
-      return type(std::unexpect, std::move(this->error()));
+      return ::fn::detail::_error_path([&] { return type(std::unexpect, std::move(this->error())); });
   }
 
   // transform_error not void
@@ -397,9 +398,10 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using error_type = ::fn::detail::_invoke_result_t<Fn, error_type &>;
     using type = expected<T, error_type>;
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error()));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error())); });
   }
 
   template <typename Fn>
@@ -409,9 +411,10 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using error_type = ::fn::detail::_invoke_result_t<Fn, error_type const &>;
     using type = expected<T, error_type>;
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error()));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error())); });
   }
 
   template <typename Fn> constexpr auto transform_error(Fn &&fn) && requires (not std::same_as<T, void>)
@@ -419,9 +422,10 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using error_type = ::fn::detail::_invoke_result_t<Fn, error_type &&>;
     using type = expected<T, error_type>;
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error())));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error()))); });
   }
 
   template <typename Fn> constexpr auto transform_error(Fn &&fn) const && requires (not std::same_as<T, void>)
@@ -429,9 +433,10 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     using error_type = ::fn::detail::_invoke_result_t<Fn, error_type const &&>;
     using type = expected<T, error_type>;
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error())));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error()))); });
   }
 
   // transform_error void
@@ -444,7 +449,8 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error()));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error())); });
   }
 
   template <typename Fn>
@@ -456,7 +462,8 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error()));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), this->error())); });
   }
 
   template <typename Fn>
@@ -468,7 +475,8 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error())));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error()))); });
   }
 
   template <typename Fn>
@@ -480,21 +488,36 @@ template <typename T, typename Err> struct expected final : std::expected<T, Err
     if (this->has_value())
       return type();
     else
-      return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error())));
+      return ::fn::detail::_error_path(
+          [&] { return type(std::unexpect, ::fn::detail::_invoke(FWD(fn), std::move(this->error()))); });
   }
 };
 
+namespace detail {
+// NOTE `operator&` copies (or moves) the value or error of each operand into the result `T`
+template <typename Op>
+constexpr bool _is_nothrow_expected_and_operand
+    = (std::is_void_v<typename std::remove_cvref_t<Op>::value_type>
+       || std::is_nothrow_constructible_v<typename std::remove_cvref_t<Op>::value_type, decltype(*std::declval<Op>())>)
+      && std::is_nothrow_constructible_v<typename std::remove_cvref_t<Op>::error_type,
+                                         decltype(std::declval<Op>().error())>;
+
+template <typename T, typename... Ops>
+constexpr bool _is_nothrow_expected_and
+    = std::is_nothrow_move_constructible_v<T> && (... && _is_nothrow_expected_and_operand<Ops>);
+} // namespace detail
+
 // When any of the sides is expected<void, ...>, we do not produce expected<pack<...>, ...>
 // Instead just elide void and carry non-void (or elide both voids if that's what we get)
 template <some_expected_non_void Lh, some_expected_void Rh>
   requires std::same_as<typename std::remove_cvref_t<Lh>::error_type, typename std::remove_cvref_t<Rh>::error_type>
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
+constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept(detail::_is_nothrow_expected_and<std::remove_cvref_t<Lh>, Lh, Rh>)
 {
   using value_type = std::remove_cvref_t<Lh>::value_type;
   using error_type = std::remove_cvref_t<Lh>::error_type;
   using type = expected<value_type, error_type>;
   if (lh.has_value() && rh.has_value())
-    return type{std::in_place, FWD(lh).value()};
+    return type{std::in_place, *FWD(lh)};
   else if (not lh.has_value())
     return type{std::unexpect, FWD(lh).error()};
   else
@@ -503,13 +526,13 @@ constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
 
 template <some_expected_void Lh, some_expected_non_void Rh>
   requires std::same_as<typename std::remove_cvref_t<Lh>::error_type, typename std::remove_cvref_t<Rh>::error_type>
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
+constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept(detail::_is_nothrow_expected_and<std::remove_cvref_t<Rh>, Lh, Rh>)
 {
   using value_type = std::remove_cvref_t<Rh>::value_type;
   using error_type = std::remove_cvref_t<Rh>::error_type;
   using type = expected<value_type, error_type>;
   if (lh.has_value() && rh.has_value())
-    return type{std::in_place, FWD(rh).value()};
+    return type{std::in_place, *FWD(rh)};
   else if (not lh.has_value())
     return type{std::unexpect, FWD(lh).error()};
   else
@@ -518,7 +541,7 @@ constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
 
 template <some_expected_void Lh, some_expected_void Rh>
   requires std::same_as<typename std::remove_cvref_t<Lh>::error_type, typename std::remove_cvref_t<Rh>::error_type>
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
+constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept(detail::_is_nothrow_expected_and<std::remove_cvref_t<Rh>, Lh, Rh>)
 {
   using error_type = std::remove_cvref_t<Rh>::error_type;
   using type = expected<void, error_type>;
@@ -530,43 +553,15 @@ constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
     return type{std::unexpect, FWD(rh).error()};
 }
 
-// Overloads when both sides are non-void, producing expected<pack<...>, ...>
-template <some_expected_non_void Lh, some_expected_non_void Rh>
-  requires std::same_as<typename std::remove_cvref_t<Lh>::error_type, typename std::remove_cvref_t<Rh>::error_type>
-           && (not some_pack<typename std::remove_cvref_t<Lh>::value_type>)
-           && (not some_pack<typename std::remove_cvref_t<Rh>::value_type>)
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
-{
-  using lh_type = std::remove_cvref_t<Lh>::value_type;
-  using rh_type = std::remove_cvref_t<Rh>::value_type;
-  using value_type = pack<lh_type, rh_type>;
-  using error_type = std::remove_cvref_t<Rh>::error_type;
-  using type = expected<value_type, error_type>;
-  if (lh.has_value() && rh.has_value())
-    return type{std::in_place, pack<lh_type>{FWD(lh).value()}.append(std::in_place_type_t<rh_type>{}, FWD(rh).value())};
-  else if (not lh.has_value())
-    return type{std::unexpect, FWD(lh).error()};
-  else
-    return type{std::unexpect, FWD(rh).error()};
-}
-
+// Overloads when both sides are non-void, producing expected<pack<...>, ...> when the result is consumed; see
+// detail::pack_expr for chaining more operands
 template <some_expected_non_void Lh, some_expected_non_void Rh>
   requires std::same_as<typename std::remove_cvref_t<Lh>::error_type, typename std::remove_cvref_t<Rh>::error_type>
-           && (some_pack<typename std::remove_cvref_t<Lh>::value_type>)
            && (not some_pack<typename std::remove_cvref_t<Rh>::value_type>)
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
+constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept(detail::_is_nothrow_pack_expr_operand<Lh>
+                                                    && detail::_is_nothrow_pack_expr_operand<Rh>)
 {
-  using lh_type = std::remove_cvref_t<Lh>::value_type;
-  using rh_type = std::remove_cvref_t<Rh>::value_type;
-  using value_type = typename lh_type::template append_type<rh_type>;
-  using error_type = std::remove_cvref_t<Rh>::error_type;
-  using type = expected<value_type, error_type>;
-  if (lh.has_value() && rh.has_value())
-    return type{std::in_place, FWD(lh).value().append(std::in_place_type_t<rh_type>{}, FWD(rh).value())};
-  else if (not lh.has_value())
-    return type{std::unexpect, FWD(lh).error()};
-  else
-    return type{std::unexpect, FWD(rh).error()};
+  return detail::pack_expr(FWD(lh), FWD(rh));
 }
 
 template <some_expected_non_void Lh, some_expected_non_void Rh>
@@ -49,9 +49,9 @@ struct fail_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (v.has_value()) {
-      return type{std::unexpect, ::fn::invoke(FWD(fn), FWD(v).value())};
+      return type{std::unexpect, ::fn::invoke(FWD(fn), *FWD(v))};
     }
-    return type{std::unexpect, FWD(v).error()};
+    return ::fn::detail::_error_path([&] { return type{std::unexpect, FWD(v).error()}; });
   }
 
   [[nodiscard]] static constexpr auto operator()(some_expected_void auto &&v, auto &&fn) noexcept //
@@ -62,7 +62,7 @@ struct fail_t::apply final {
     if (v.has_value()) {
       return type{std::unexpect, ::fn::invoke(FWD(fn))};
     }
-    return type{std::unexpect, FWD(v).error()};
+    return ::fn::detail::_error_path([&] { return type{std::unexpect, FWD(v).error()}; });
   }
 
   [[nodiscard]] static constexpr auto operator()(some_optional auto &&v, auto &&fn) noexcept
@@ -71,7 +71,7 @@ struct fail_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (v.has_value()) {
-      ::fn::invoke(FWD(fn), FWD(v).value());
+      ::fn::invoke(FWD(fn), *FWD(v));
     }
     return type{std::nullopt};
   }
@@ -48,6 +48,7 @@ constexpr inline struct filter_t final {
   }
 
   struct apply;
+  struct fuse;
 } filter = {};
 
 struct filter_t::apply final {
@@ -57,9 +58,10 @@ struct filter_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (std::as_const(v).has_value()) {
-      bool const keep = ::fn::invoke(FWD(pred), std::as_const(v).value());
-      return (keep ? type{std::in_place, FWD(v).value()}
-                   : type{std::unexpect, ::fn::invoke(FWD(on_err), FWD(v).value())});
+      bool const keep = ::fn::invoke(FWD(pred), *std::as_const(v));
+      if (keep)
+        return type{std::in_place, *FWD(v)};
+      return ::fn::detail::_error_path([&] { return type{std::unexpect, ::fn::invoke(FWD(on_err), *FWD(v))}; });
     }
     return FWD(v);
   }
@@ -71,7 +73,9 @@ struct filter_t::apply final {
     using type = std::remove_cvref_t<decltype(v)>;
     if (std::as_const(v).has_value()) {
       bool const keep = ::fn::invoke(FWD(pred));
-      return (keep ? type{std::in_place} : type{std::unexpect, ::fn::invoke(FWD(on_err))});
+      if (keep)
+        return type{std::in_place};
+      return ::fn::detail::_error_path([&] { return type{std::unexpect, ::fn::invoke(FWD(on_err))}; });
     }
     return FWD(v);
   }
@@ -82,8 +86,8 @@ struct filter_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (std::as_const(v).has_value()) {
-      bool const keep = ::fn::invoke(FWD(pred), std::as_const(v).value());
-      return (keep ? type{std::in_place, FWD(v).value()} : type{std::nullopt});
+      bool const keep = ::fn::invoke(FWD(pred), *std::as_const(v));
+      return (keep ? type{std::in_place, *FWD(v)} : type{std::nullopt});
     }
     return FWD(v);
   }
@@ -92,6 +96,25 @@ struct filter_t::apply final {
   static auto operator()(some_choice auto &&v, auto &&...args) noexcept = delete;
 };
 
+// NOTE Stage of a fused `pipeline`; the value is copied if it is an lvalue, same as `apply` does
+struct filter_t::fuse final {
+  [[nodiscard]] static constexpr auto operator()(auto &&next, auto &&v, auto &&pred, auto &&...on_err) noexcept
+      -> decltype(auto)
+  {
+    bool const keep = next.call(FWD(pred), std::as_const(v));
+    if (keep) {
+      if constexpr (std::is_lvalue_reference_v<decltype(v)>)
+        return next(auto(v));
+      else
+        return next(FWD(v));
+    }
+    if constexpr (sizeof...(on_err) == 0)
+      return next.fail();
+    else
+      return ::fn::detail::_error_path([&] { return next.fail(next.call(FWD(on_err)..., FWD(v))); });
+  }
+};
+
 } // namespace fn
 
 #endif // INCLUDE_FUNCTIONAL_FILTER
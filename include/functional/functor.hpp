@@ -12,6 +12,9 @@
 #include "functional/utility.hpp"
 
 #include <concepts>
+#include <cstddef>
+#include <expected>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -20,12 +23,22 @@ template <typename Functor, typename V, typename... Args>
 concept monadic_invocable //
     = some_monadic_type<V> && invocable<typename Functor::apply, V, Args...>;
 
+template <typename Functor, typename... Args> struct functor;
+template <typename... Fs> struct pipeline;
+
+namespace detail {
+template <typename T> constexpr bool _is_functor = false;
+template <typename Functor, typename... Args> constexpr bool _is_functor<::fn::functor<Functor, Args...>> = true;
+template <typename T>
+concept _some_functor = _is_functor<std::remove_cvref_t<T>>;
+} // namespace detail
+
 template <typename Functor, typename... Args> struct functor final {
   using functor_type = Functor;
   using functor_apply = typename functor_type::apply;
   static constexpr unsigned size = sizeof...(Args);
   using data_t = pack<as_value_t<Args>...>;
-  data_t data;
+  [[no_unique_address]] data_t data; // NOTE Stateless functions take no storage
 
   static_assert(sizeof...(Args) > 0); // NOTE Consider relaxing
   static_assert(std::is_empty_v<functor_type> && std::is_empty_v<functor_apply>
@@ -37,6 +50,123 @@ template <typename Functor, typename... Args> struct functor final {
   {
     return FWD(self).data.invoke(functor_apply{}, FWD(v));
   }
+
+  // NOTE Composition with another functor, to be applied to a value later
+  [[nodiscard]] constexpr friend auto operator|(auto &&self, auto &&rh) noexcept
+      -> pipeline<functor, std::remove_cvref_t<decltype(rh)>>
+    requires std::same_as<std::remove_cvref_t<decltype(self)>, functor> && detail::_some_functor<decltype(rh)>
+  {
+    return {{FWD(self), FWD(rh)}};
+  }
+};
+
+namespace detail {
+// NOTE Plain value passed between the stages of a fused pipeline for `expected<void, E>`
+struct _fused_void final {};
+
+template <typename F>
+concept _fusible = requires { typename F::functor_type::fuse; };
+
+template <std::size_t I, typename R, typename Self, typename V> constexpr auto _fused_run(Self &&self, V &&v) -> R;
+
+// NOTE Passed to `fuse` of each stage, which either calls it with the plain value for the next stage, or returns
+// the result of `fail` i.e. a value of the final type in the error state.
+template <std::size_t I, typename R, typename Self> struct _fused_next final {
+  Self &&self;
+
+  constexpr auto operator()(auto &&v) noexcept -> R { return _fused_run<I, R>(FWD(self), FWD(v)); }
+  constexpr auto operator()() noexcept -> R { return _fused_run<I, R>(FWD(self), _fused_void{}); }
+
+  template <typename V> static constexpr auto call(auto &&fn, V &&v) noexcept -> decltype(auto)
+  {
+    if constexpr (std::same_as<std::remove_cvref_t<V>, _fused_void>)
+      return ::fn::detail::_invoke(FWD(fn));
+    else
+      return ::fn::detail::_invoke(FWD(fn), FWD(v));
+  }
+
+  static constexpr auto fail(auto &&...e) noexcept -> R
+  {
+    if constexpr (some_expected<R>)
+      return ::fn::detail::_error_path([&] { return R(std::unexpect, FWD(e)...); });
+    else
+      return R(std::nullopt);
+  }
+};
+
+template <std::size_t I, typename R, typename Self, typename V> constexpr auto _fused_run(Self &&self, V &&v) -> R
+{
+  using data_t = typename std::remove_cvref_t<Self>::data_t;
+  if constexpr (I == data_t::size) {
+    if constexpr (std::same_as<std::remove_cvref_t<V>, _fused_void>)
+      return R();
+    else
+      return R(std::in_place, FWD(v));
+  } else {
+    auto &&stage = data_t::template _get<I>(FWD(self).data);
+    using fuse = typename std::remove_cvref_t<decltype(stage)>::functor_type::fuse;
+    return FWD(stage).data.invoke(fuse{}, _fused_next<I + 1, R, Self>{FWD(self)}, FWD(v));
+  }
+}
+
+// NOTE Always a value, since a reference returned by the last stage (e.g. `inspect`) may refer to an intermediate
+// result
+template <typename V, typename... Fs>
+using _pipeline_result_t = std::remove_cvref_t<decltype((std::declval<V>() | ... | std::declval<Fs>()))>;
+
+template <typename V, typename... Fs>
+concept _pipeline_fusible = (some_expected<V> || some_optional<V>) && (... && _fusible<std::remove_cvref_t<Fs>>);
+} // namespace detail
+
+// NOTE Functors composed without a value e.g. `and_then(f) | transform(g) | filter(p, e)`, applied to `expected`
+// or `optional` as a single fused function. If every stage supports fusion (i.e. its `functor_type` has `fuse`), the
+// stages pass plain values to each other rather than `expected` or `optional`, and the first error jumps straight to
+// the end. Otherwise the functors are applied one by one, same as `v | f1 | f2 ...`; the result is the same either way.
+template <typename... Fs> struct pipeline final {
+  static_assert(sizeof...(Fs) >= 2);
+  static_assert((... && detail::_some_functor<Fs>));
+
+  using data_t = pack<Fs...>;
+  [[no_unique_address]] data_t data;
+
+  [[nodiscard]] constexpr friend auto operator|(some_monadic_type auto &&v, auto &&self) noexcept -> decltype(auto)
+    requires std::same_as<std::remove_cvref_t<decltype(self)>, pipeline>
+             && requires {
+                  typename detail::_pipeline_result_t<decltype(v), apply_const_lvalue_t<decltype(self), Fs &&>...>;
+                }
+  {
+    using type = detail::_pipeline_result_t<decltype(v), apply_const_lvalue_t<decltype(self), Fs &&>...>;
+    if constexpr (detail::_pipeline_fusible<decltype(v), apply_const_lvalue_t<decltype(self), Fs &&>...>) {
+      using next = detail::_fused_next<0, type, decltype(self)>;
+      if (not v.has_value()) {
+        if constexpr (some_expected<decltype(v)>)
+          return next::fail(FWD(v).error());
+        else
+          return next::fail();
+      }
+      if constexpr (std::is_void_v<typename std::remove_cvref_t<decltype(v)>::value_type>)
+        return next{FWD(self)}();
+      else
+        return next{FWD(self)}(*FWD(v));
+    } else {
+      return FWD(self).data.invoke([&v](auto &&...fs) noexcept -> type { return (FWD(v) | ... | FWD(fs)); });
+    }
+  }
+
+  template <typename Self, typename Rh>
+  [[nodiscard]] constexpr friend auto operator|(Self &&self, Rh &&rh) noexcept
+      -> pipeline<Fs..., std::remove_cvref_t<Rh>>
+    requires std::same_as<std::remove_cvref_t<Self>, pipeline> && detail::_some_functor<Rh>
+  {
+    return _append(FWD(self), FWD(rh), std::index_sequence_for<Fs...>{});
+  }
+
+  template <typename Self, typename Rh, std::size_t... Is>
+  [[nodiscard]] static constexpr auto _append(Self &&self, Rh &&rh, std::index_sequence<Is...>) noexcept
+      -> pipeline<Fs..., std::remove_cvref_t<Rh>>
+  {
+    return {{data_t::template _get<Is>(FWD(self).data)..., FWD(rh)}};
+  }
 };
 
 } // namespace fn
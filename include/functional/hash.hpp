@@ -0,0 +1,146 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_HASH
+#define INCLUDE_FUNCTIONAL_HASH
+
+#include "functional/choice.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/detail/variadic_union.hpp"
+#include "functional/pack.hpp"
+#include "functional/sum.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace fn {
+
+namespace detail {
+template <typename T>
+concept _hashable = requires(T const &v) {
+  { std::hash<T>{}(v) } -> std::convertible_to<std::size_t>;
+};
+
+// NOTE Same mixing as boost::hash_combine
+[[nodiscard]] constexpr auto _hash_combine(std::size_t seed, std::size_t v) noexcept -> std::size_t
+{
+  return seed ^ (v + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+}
+
+template <typename T, typename... Ts> [[nodiscard]] auto _hash_sum(T const &v) noexcept -> std::size_t
+{
+  return _hash_combine(type_index<T, Ts...>, std::hash<T>{}(v));
+}
+
+template <typename T, typename... Ts> [[nodiscard]] constexpr auto _get_sum(sum<Ts...> const &s) noexcept -> T const &
+{
+  return *ptr_variadic_union<T, typename sum<Ts...>::data_t>(s.data);
+}
+} // namespace detail
+
+// NOTE Transparent equality of `sum` (or `choice`) and any of its alternatives, to look up elements of a container
+// keyed by `sum` without constructing one. Use with `std::hash` specializations below, which are also transparent,
+// e.g. `std::unordered_map<sum<Ts...>, V, std::hash<sum<Ts...>>, sum_equal_to>`
+struct sum_equal_to final {
+  using is_transparent = void;
+
+  template <typename... Ts, typename... Tx>
+  [[nodiscard]] constexpr bool operator()(sum<Ts...> const &lh, sum<Tx...> const &rh) const noexcept
+    requires(... && (std::equality_comparable<Ts> || not detail::type_one_of<Ts, Tx...>))
+  {
+    return lh == rh;
+  }
+
+  template <typename... Ts, typename T>
+    requires sum<Ts...>::template has_type<T> && std::equality_comparable<T>
+  [[nodiscard]] constexpr bool operator()(sum<Ts...> const &lh, T const &rh) const noexcept
+  {
+    return lh.index == detail::type_index<T, Ts...> && detail::_get_sum<T>(lh) == rh;
+  }
+
+  template <typename T, typename... Ts>
+    requires sum<Ts...>::template has_type<T> && std::equality_comparable<T>
+  [[nodiscard]] constexpr bool operator()(T const &lh, sum<Ts...> const &rh) const noexcept
+  {
+    return rh.index == detail::type_index<T, Ts...> && lh == detail::_get_sum<T>(rh);
+  }
+};
+
+// NOTE Transparent ordering consistent with `operator<=>` of `sum`, to look up elements of an ordered container keyed
+// by `sum` (or `choice`) without constructing one, e.g. `std::map<sum<Ts...>, V, sum_less>`
+struct sum_less final {
+  using is_transparent = void;
+
+  template <typename... Ts>
+  [[nodiscard]] constexpr bool operator()(sum<Ts...> const &lh, sum<Ts...> const &rh) const noexcept
+    requires std::three_way_comparable<sum<Ts...>>
+  {
+    return lh < rh;
+  }
+
+  template <typename... Ts, typename T>
+    requires sum<Ts...>::template has_type<T> && std::three_way_comparable<T>
+  [[nodiscard]] constexpr bool operator()(sum<Ts...> const &lh, T const &rh) const noexcept
+  {
+    constexpr auto index = detail::type_index<T, Ts...>;
+    return lh.index != index ? lh.index < index : detail::_get_sum<T>(lh) < rh;
+  }
+
+  template <typename T, typename... Ts>
+    requires sum<Ts...>::template has_type<T> && std::three_way_comparable<T>
+  [[nodiscard]] constexpr bool operator()(T const &lh, sum<Ts...> const &rh) const noexcept
+  {
+    constexpr auto index = detail::type_index<T, Ts...>;
+    return index != rh.index ? index < rh.index : lh < detail::_get_sum<T>(rh);
+  }
+};
+
+} // namespace fn
+
+// NOTE Hash of the alternative index combined with the hash of the value, computed in a single dispatch. Also
+// accepts any of the alternatives, yielding the same hash as `sum` holding the same value (see `fn::sum_equal_to`)
+template <typename... Ts>
+  requires(... && fn::detail::_hashable<Ts>)
+struct std::hash<fn::sum<Ts...>> {
+  using is_transparent = void;
+
+  [[nodiscard]] auto operator()(fn::sum<Ts...> const &v) const noexcept -> std::size_t
+  {
+    return fn::detail::invoke_variadic_union<std::size_t, typename fn::sum<Ts...>::data_t>( //
+        v.data, v.index, []<typename T>(std::in_place_type_t<T>, auto const &v) noexcept {
+          return fn::detail::_hash_sum<T, Ts...>(v);
+        });
+  }
+
+  template <typename T>
+    requires fn::sum<Ts...>::template has_type<T>
+  [[nodiscard]] auto operator()(T const &v) const noexcept -> std::size_t
+  {
+    return fn::detail::_hash_sum<T, Ts...>(v);
+  }
+};
+
+template <typename... Ts>
+  requires(... && fn::detail::_hashable<Ts>)
+struct std::hash<fn::choice<Ts...>> : std::hash<fn::sum<Ts...>> {};
+
+template <typename... Ts>
+  requires(... && fn::detail::_hashable<std::remove_cvref_t<Ts>>)
+struct std::hash<fn::pack<Ts...>> {
+  [[nodiscard]] auto operator()(fn::pack<Ts...> const &v) const noexcept -> std::size_t
+  {
+    return v.invoke([](auto const &...args) noexcept {
+      std::size_t result = 0;
+      ((result = fn::detail::_hash_combine(result, std::hash<std::remove_cvref_t<Ts>>{}(args))), ...);
+      return result;
+    });
+  }
+};
+
+#endif // INCLUDE_FUNCTIONAL_HASH
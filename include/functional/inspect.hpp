@@ -45,6 +45,7 @@ constexpr inline struct inspect_t final {
   }
 
   struct apply;
+  struct fuse;
 } inspect = {};
 
 struct inspect_t::apply final {
@@ -52,7 +53,7 @@ struct inspect_t::apply final {
     requires invocable_inspect<decltype(fn), decltype(v)>
   {
     if (v.has_value()) {
-      ::fn::invoke(FWD(fn), std::as_const(v).value()); // side-effects only
+      ::fn::invoke(FWD(fn), *std::as_const(v)); // side-effects only
     }
     return FWD(v);
   }
@@ -70,7 +71,7 @@ struct inspect_t::apply final {
     requires invocable_inspect<decltype(fn), decltype(v)>
   {
     if (v.has_value()) {
-      ::fn::invoke(FWD(fn), std::as_const(v).value()); // side-effects only
+      ::fn::invoke(FWD(fn), *std::as_const(v)); // side-effects only
     }
     return FWD(v);
   }
@@ -83,6 +84,15 @@ struct inspect_t::apply final {
   }
 };
 
+// NOTE Stage of a fused `pipeline`
+struct inspect_t::fuse final {
+  [[nodiscard]] static constexpr auto operator()(auto &&next, auto &&v, auto &&fn) noexcept -> decltype(auto)
+  {
+    next.call(FWD(fn), std::as_const(v)); // side-effects only
+    return next(FWD(v));
+  }
+};
+
 } // namespace fn
 
 #endif // INCLUDE_FUNCTIONAL_INSPECT
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_INVOKE_BATCHED
+#define INCLUDE_FUNCTIONAL_INVOKE_BATCHED
+
+#include "functional/box.hpp"
+#include "functional/detail/functional.hpp"
+#include "functional/detail/variadic_union.hpp"
+#include "functional/functional.hpp"
+#include "functional/fwd.hpp"
+#include "functional/sum.hpp"
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fn {
+
+namespace detail {
+template <std::size_t I, bool Typed, typename Fn, typename S>
+constexpr void _invoke_batched_run(S *first, std::size_t const *begin, std::size_t const *end, Fn &&fn)
+{
+  using type = typename std::remove_const_t<S>::template select_nth<I>;
+  using data_t = typename std::remove_const_t<S>::data_t;
+  // NOTE Same as `sum::invoke`, the function sees the value held by a box rather than the box itself
+  auto &&unboxing = _unboxing<std::remove_const_t<S>::_has_box>(fn);
+  for (; begin != end; ++begin) {
+    auto &v = *ptr_variadic_union<type, data_t>(first[*begin].data);
+    if constexpr (Typed)
+      _invoke(unboxing, std::in_place_type<type>, v);
+    else
+      _invoke(unboxing, v);
+  }
+}
+} // namespace detail
+
+// NOTE Visit every sum in a contiguous range, grouped by alternative. Positions of elements are first bucketed by
+// their discriminator (a counting sort) and then the visitor is called once per element, one alternative at a time,
+// in the normalized order of alternatives. Within each alternative the original order of elements is preserved.
+// This trades a single pass over the discriminators (plus temporary storage for positions) for homogeneous runs,
+// where the visitor can be inlined and vectorized and branches are trivially predictable.
+template <typename Fn, std::ranges::contiguous_range R>
+  requires some_sum<std::ranges::range_value_t<R>> && std::ranges::sized_range<R>
+           && (typelist_invocable<Fn, std::ranges::range_reference_t<R>>
+               || typelist_type_invocable<Fn, std::ranges::range_reference_t<R>>)
+constexpr void invoke_batched(R &&r, Fn &&fn)
+{
+  using sum_t = std::ranges::range_value_t<R>;
+  constexpr bool typed = typelist_type_invocable<Fn, std::ranges::range_reference_t<R>>;
+  auto *const first = std::ranges::data(r);
+  std::size_t const size = std::ranges::size(r);
+
+  std::array<std::size_t, sum_t::size + 1> start = {};
+  for (std::size_t i = 0; i < size; ++i)
+    ++start[static_cast<std::size_t>(first[i].index) + 1];
+  for (std::size_t j = 1; j < start.size(); ++j)
+    start[j] += start[j - 1];
+
+  std::vector<std::size_t> order(size);
+  auto next = start;
+  for (std::size_t i = 0; i < size; ++i)
+    order[next[first[i].index]++] = i;
+
+  std::size_t const *const positions = order.data();
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (..., detail::_invoke_batched_run<Is, typed>(first, positions + start[Is], positions + start[Is + 1], fn));
+  }(std::make_index_sequence<sum_t::size>{});
+}
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_INVOKE_BATCHED
@@ -0,0 +1,238 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_MATCH
+#define INCLUDE_FUNCTIONAL_MATCH
+
+#include "functional/box.hpp"
+#include "functional/choice.hpp"
+#include "functional/detail/functional.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/detail/traits.hpp"
+#include "functional/detail/variadic_union.hpp"
+#include "functional/fwd.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fn {
+
+namespace detail {
+template <typename Fn, typename... Ts> struct _match_on final {
+  Fn fn;
+};
+template <typename Fn> struct _match_otherwise final {
+  Fn fn;
+};
+
+// NOTE Functions in match arms may take the value only, or `std::in_place_type_t` tag and the value
+template <typename Fn, typename T, typename V>
+constexpr bool _match_invocable = _is_invocable_v<Fn, std::in_place_type_t<T>, V> || _is_invocable_v<Fn, V>;
+
+template <typename T, typename V> [[nodiscard]] constexpr auto _match_invoke(auto &&fn, V &&v) -> decltype(auto)
+{
+  if constexpr (_is_invocable_v<decltype(fn), std::in_place_type_t<T>, V>)
+    return _invoke(FWD(fn), std::in_place_type<T>, FWD(v));
+  else
+    return _invoke(FWD(fn), FWD(v));
+}
+
+template <typename Arm> constexpr bool _is_match_on = false;
+template <typename Fn, typename... Ts> constexpr bool _is_match_on<_match_on<Fn, Ts...>> = true;
+template <typename Arm> constexpr bool _is_match_otherwise = false;
+template <typename Fn> constexpr bool _is_match_otherwise<_match_otherwise<Fn>> = true;
+template <typename Arm> constexpr bool _is_match_plain = not(_is_match_on<Arm> || _is_match_otherwise<Arm>);
+
+// NOTE Placeholder in the overload set of plain arms, for the position of `fn::on` or `fn::otherwise` arm
+template <typename... Args> constexpr bool _match_never = false;
+template <std::size_t J> struct _match_none {
+  template <typename... Args>
+    requires _match_never<Args...>
+  void operator()(Args &&...) const noexcept;
+};
+
+template <std::size_t J, typename Arm>
+using _match_plain_t
+    = std::conditional_t<_is_match_plain<std::remove_cvref_t<Arm>>, std::remove_cvref_t<Arm>, _match_none<J>>;
+
+template <std::size_t J, typename Arm> [[nodiscard]] constexpr auto _match_plain(Arm &&arm) -> _match_plain_t<J, Arm>
+{
+  if constexpr (_is_match_plain<std::remove_cvref_t<Arm>>)
+    return FWD(arm);
+  else
+    return {};
+}
+
+// NOTE Plain arms are moved (or copied) into the overload set, other arms are left intact
+template <std::size_t... Js, typename... Arms>
+[[nodiscard]] constexpr auto _match_overload(std::index_sequence<Js...>, Arms &&...arms)
+    -> ::fn::overload<_match_plain_t<Js, Arms>...>
+{
+  return {_match_plain<Js>(FWD(arms))...};
+}
+
+template <typename T, typename Arm> constexpr bool _match_on_selected = false;
+template <typename T, typename Fn, typename... Ts>
+constexpr bool _match_on_selected<T, _match_on<Fn, Ts...>> = type_one_of<T, Ts...>;
+
+template <typename S, typename Arm> constexpr bool _match_names_alternatives = true;
+template <typename S, typename Fn, typename... Ts>
+constexpr bool _match_names_alternatives<S, _match_on<Fn, Ts...>> = (... && S::template has_type<Ts>);
+
+// NOTE Position of the arm selected for an alternative, with `sizeof...(Arms)` for the overload set of plain arms,
+// or `sizeof...(Arms) + 1` if there is no such arm
+template <typename T, typename V, typename Ov, typename... Arms> constexpr std::size_t _match_select = [] {
+  constexpr std::size_t size = sizeof...(Arms);
+  constexpr bool on[] = {_match_on_selected<T, std::remove_cvref_t<Arms>>...};
+  constexpr bool otherwise[] = {_is_match_otherwise<std::remove_cvref_t<Arms>>...};
+  for (std::size_t i = 0; i < size; ++i) {
+    if (on[i])
+      return i;
+  }
+  if (_match_invocable<Ov &, T, V>)
+    return size;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (otherwise[i])
+      return i;
+  }
+  return size + 1;
+}();
+
+template <typename S, typename Ov, typename Is, typename... Arms> struct _match_traits;
+template <typename S, typename Ov, std::size_t... Is, typename... Arms>
+struct _match_traits<S, Ov, std::index_sequence<Is...>, Arms...> final {
+  template <std::size_t I> using alternative = typename std::remove_cvref_t<S>::template select_nth<I>;
+  template <std::size_t I> using type = _visible_t<::fn::sum, alternative<I>>;
+  template <std::size_t I> using value = apply_const_lvalue_t<S, type<I> &&>;
+  template <std::size_t I> static constexpr std::size_t arm = _match_select<type<I>, value<I>, Ov, Arms...>;
+
+  static constexpr bool exhaustive = (... && (arm<Is> <= sizeof...(Arms)));
+  static constexpr bool named
+      = (... && _match_names_alternatives<std::remove_cvref_t<S>, std::remove_cvref_t<Arms>>);
+  static constexpr bool single_otherwise = (0 + ... + _is_match_otherwise<std::remove_cvref_t<Arms>>) <= 1;
+  // NOTE Every `fn::on` arm must be selected for some alternative, i.e. not listed in an earlier `fn::on` only
+  static constexpr bool reachable = [] {
+    constexpr std::size_t selected[] = {arm<Is>...};
+    constexpr bool on[] = {_is_match_on<std::remove_cvref_t<Arms>>...};
+    for (std::size_t j = 0; j < sizeof...(Arms); ++j) {
+      if (on[j] && std::ranges::find(selected, j) == std::ranges::end(selected))
+        return false;
+    }
+    return true;
+  }();
+
+  template <std::size_t I> static constexpr auto fn(Ov &ov, auto &&...arms) noexcept -> decltype(auto)
+  {
+    if constexpr (arm<I> == sizeof...(Arms))
+      return ov;
+    else
+      return (std::get<arm<I>>(std::forward_as_tuple(FWD(arms)...)).fn);
+  }
+  template <std::size_t I> using fn_t = decltype(fn<I>(std::declval<Ov &>(), std::declval<Arms>()...));
+
+  template <std::size_t I> static constexpr bool invocable = _match_invocable<fn_t<I>, type<I>, value<I>>;
+
+  template <std::size_t I> static constexpr auto result()
+  {
+    using result = decltype(_match_invoke<type<I>>(std::declval<fn_t<I>>(), std::declval<value<I>>()));
+    return std::type_identity<result>{};
+  }
+  template <std::size_t I> using result_t = typename decltype(result<I>())::type;
+};
+
+template <typename S, typename Ov, typename... Arms>
+using _match_traits_t = _match_traits<S, Ov, std::make_index_sequence<std::remove_cvref_t<S>::size>, Arms...>;
+
+template <std::size_t I, typename R, typename S, typename Ov, typename... Arms>
+constexpr auto _match_nth(S &&s, Ov &ov, Arms &&...arms) -> R
+{
+  using traits = _match_traits_t<S, Ov, Arms...>;
+  using type = typename traits::template alternative<I>;
+  using data_t = typename std::remove_cvref_t<S>::data_t;
+  return static_cast<R>(_match_invoke<typename traits::template type<I>>(
+      traits::template fn<I>(ov, FWD(arms)...),
+      _unbox(static_cast<apply_const_lvalue_t<S, type &&>>(*ptr_variadic_union<type, data_t>(s.data)))));
+}
+
+template <typename R, typename S, typename Ov, typename Is, typename... Arms> struct _match_table;
+template <typename R, typename S, typename Ov, std::size_t... Is, typename... Arms>
+struct _match_table<R, S, Ov, std::index_sequence<Is...>, Arms...> final {
+  static constexpr R (*value[])(S &&, Ov &, Arms &&...) = {&_match_nth<Is, R, S, Ov, Arms...>...};
+};
+
+template <typename T, typename Traits, typename Is> struct _match_result final {
+  using type = T;
+};
+template <typename Traits, std::size_t I0, std::size_t... Is>
+struct _match_result<_invoke_autodetect_tag, Traits, std::index_sequence<I0, Is...>> final {
+  using R0 = typename Traits::template result_t<I0>;
+  static_assert((... && std::is_same_v<R0, typename Traits::template result_t<Is>>),
+                "All arms must return the same type, or the type must be passed to fn::match<R>");
+  using type = R0;
+};
+
+template <typename R, typename S, typename... Arms>
+[[nodiscard]] constexpr auto _match(S &&s, Arms &&...arms) -> decltype(auto)
+{
+  auto ov = _match_overload(std::index_sequence_for<Arms...>{}, FWD(arms)...);
+  using ov_t = decltype(ov);
+
+  using traits = _match_traits_t<S, ov_t, Arms...>;
+  using is = std::make_index_sequence<std::remove_cvref_t<S>::size>;
+  static_assert(traits::exhaustive, "Every alternative must be matched by an arm");
+  static_assert(traits::named, "Every type in fn::on<Ts...> must be an alternative");
+  static_assert(traits::reachable, "Every fn::on<Ts...> arm must match an alternative not matched before");
+  static_assert(traits::single_otherwise, "Only one fn::otherwise arm is allowed");
+  static_assert([]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... && traits::template invocable<Is>);
+  }(is{}), "Every arm must be invocable with the alternatives it matches");
+
+  using type = _match_result<R, traits, is>::type;
+  using table = _match_table<type, S, ov_t, is, Arms...>;
+  return table::value[s.index](FWD(s), ov, FWD(arms)...);
+}
+} // namespace detail
+
+// NOTE Arm of `fn::match` for the listed alternatives only
+template <typename... Ts, typename Fn>
+  requires(sizeof...(Ts) > 0)
+[[nodiscard]] constexpr auto on(Fn &&fn) noexcept -> detail::_match_on<std::decay_t<Fn>, Ts...>
+{
+  return {FWD(fn)};
+}
+
+// NOTE Arm of `fn::match` for all alternatives not matched by other arms
+template <typename Fn>
+[[nodiscard]] constexpr auto otherwise(Fn &&fn) noexcept -> detail::_match_otherwise<std::decay_t<Fn>>
+{
+  return {FWD(fn)};
+}
+
+// NOTE Exhaustive pattern match of `sum` or `choice`, with arms of three kinds:
+// - `fn::on<Ts...>(fn)` matches the listed alternatives, and the first such arm is selected,
+// - other functions form an overload set, as with `fn::overload`, which matches alternatives not listed in `fn::on`,
+// - `fn::otherwise(fn)` matches the remaining alternatives.
+// Functions take either the value, or a `std::in_place_type_t` tag and the value, and the value held by a `box` is
+// passed rather than the box itself. It is a compilation error if an alternative is not matched by any arm, or if a
+// `fn::on` arm is never selected. The result type must be the same for all alternatives, unless passed explicitly as
+// `fn::match<R>(...)`. Dispatch is a single lookup in a table of functions, one for each alternative.
+template <typename R = detail::_invoke_autodetect_tag, typename S, typename... Arms>
+[[nodiscard]] constexpr auto match(S &&s, Arms &&...arms) -> decltype(auto)
+  requires(some_sum<S> || some_choice<S>) && (sizeof...(Arms) > 0)
+{
+  if constexpr (some_choice<S>)
+    return detail::_match<R>(FWD(s).value(), FWD(arms)...);
+  else
+    return detail::_match<R>(FWD(s), FWD(arms)...);
+}
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_MATCH
@@ -0,0 +1,246 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_NICHE
+#define INCLUDE_FUNCTIONAL_NICHE
+
+#include "functional/detail/functional.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/functional.hpp"
+#include "functional/fwd.hpp"
+#include "functional/sum.hpp"
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace fn {
+
+// NOTE Opt-in declaration of bits which are always zero in the object representation of every valid value of `T`.
+// A specialization must provide an unsigned integral `storage_t` of the same size as `T`, and `spare_bits` mask of
+// type `storage_t`. Users may specialize it e.g. for enums with a small range of values.
+template <typename T> struct niche_traits; // Intentionally incomplete
+
+// NOTE Low bits of object pointers are zero as long as the pointer is suitably aligned
+template <typename T>
+  requires std::is_object_v<T>
+struct niche_traits<T *> {
+  using storage_t = std::uintptr_t;
+  static constexpr storage_t spare_bits = alignof(T) - 1;
+};
+
+template <> struct niche_traits<bool> {
+  using storage_t = std::uint8_t;
+  static constexpr storage_t spare_bits = 0xfe;
+};
+
+namespace detail {
+template <typename T>
+concept _has_niche = requires {
+  typename niche_traits<T>::storage_t;
+  { niche_traits<T>::spare_bits } -> std::convertible_to<typename niche_traits<T>::storage_t>;
+} && std::unsigned_integral<typename niche_traits<T>::storage_t> && std::is_trivially_copyable_v<T>
+                     && (sizeof(T) == sizeof(typename niche_traits<T>::storage_t));
+
+// NOTE Member functions `invoke` and `transform` are noexcept if `fn` does not throw for any alternative, and neither
+// does the conversion of its result to the result type, same as for `sum`
+template <template <typename, typename, typename> typename Result, typename Fn, typename Self>
+constexpr bool _is_nothrow_niche_invoke
+    = _is_nothrow_rts_invocable<typename Result<Fn, Self, std::remove_cvref_t<Self>>::type, Fn, Self>;
+template <template <typename, typename, typename> typename Result, typename Fn, typename Self>
+constexpr bool _is_nothrow_niche_invoke_type
+    = _is_nothrow_rtst_invocable<typename Result<Fn, Self, std::remove_cvref_t<Self>>::type, Fn, Self>;
+} // namespace detail
+
+template <typename T>
+concept some_niche = detail::_has_niche<T>;
+
+template <typename... Ts> struct niche_sum;
+template <> struct niche_sum<>; // Intentionally incomplete
+
+// NOTE Sum with the discriminator stored in spare bits of the payload, hence exactly the size of its alternatives.
+// Since the stored bits are not a valid object of any alternative, values are decoded on access: `invoke` passes
+// a decoded copy (which is written back after the call, for non-const `niche_sum`) and `get` returns a copy. It
+// is a precondition of construction that spare bits of the value are zero, e.g. that pointers are aligned.
+template <typename... Ts>
+  requires(sizeof...(Ts) > 0)
+struct niche_sum<Ts...> {
+  static_assert((... && detail::_is_valid_sum_subtype<Ts>));
+  static_assert((... && detail::_has_niche<Ts>));
+  static_assert(std::same_as<typename detail::normalized<Ts...>::template apply<::fn::niche_sum>, niche_sum>);
+
+  using value_type = sum<Ts...>;
+  using storage_t = typename niche_traits<detail::select_nth_t<0, Ts...>>::storage_t;
+  static_assert((... && std::is_same_v<storage_t, typename niche_traits<Ts>::storage_t>));
+
+  static constexpr std::size_t size = sizeof...(Ts);
+  template <std::size_t I> using select_nth = detail::select_nth_t<I, Ts...>;
+  template <typename T> static constexpr bool has_type = detail::type_one_of<T, Ts...>;
+
+  static constexpr storage_t _spare_bits = (... & static_cast<storage_t>(niche_traits<Ts>::spare_bits));
+  static constexpr int _tag_bits = std::bit_width(sizeof...(Ts) - 1);
+  static constexpr int _tag_shift = _spare_bits == 0 ? 0 : std::countr_zero(_spare_bits);
+  static_assert(_tag_bits == 0 || std::countr_one(static_cast<storage_t>(_spare_bits >> _tag_shift)) >= _tag_bits,
+                "Not enough spare bits common to all alternatives");
+  static constexpr storage_t _tag_mask = static_cast<storage_t>(((storage_t(1) << _tag_bits) - 1) << _tag_shift);
+
+  storage_t data;
+
+  template <typename T>
+  constexpr niche_sum(T const &v) noexcept
+    requires has_type<T>
+      : data(_encode(v))
+  {
+  }
+
+  template <typename T>
+  constexpr explicit niche_sum(std::in_place_type_t<T>, auto &&...args) noexcept(
+      std::is_nothrow_constructible_v<T, decltype(args)...>)
+    requires has_type<T> && (std::is_constructible_v<T, decltype(args)...>)
+      : data(_encode(T(FWD(args)...)))
+  {
+  }
+
+  constexpr explicit niche_sum(value_type const &v) noexcept
+      : data(v.template invoke_r<storage_t>([](auto const &v) { return _encode(v); }))
+  {
+  }
+
+  [[nodiscard]] constexpr auto to_sum() const noexcept -> value_type
+  {
+    return invoke([]<typename T>(std::in_place_type_t<T>, T const &v) -> value_type { //
+      return value_type{std::in_place_type<T>, v};
+    });
+  }
+
+  [[nodiscard]] constexpr std::size_t index() const noexcept
+  {
+    return static_cast<std::size_t>((data & _tag_mask) >> _tag_shift);
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr bool has_value(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return index() == detail::type_index<T, Ts...>;
+  }
+
+  // NOTE Precondition: has_value<T>()
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr T get(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return _decode<T>(data);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_niche_invoke<detail::_typelist_collapsing_sum, Fn, value_type const &>)
+    requires typelist_invocable<Fn, value_type const &> && (not typelist_type_invocable<Fn, value_type const &>)
+  {
+    using type = detail::_typelist_collapsing_sum<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, false>(*this, index(), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_niche_invoke_type<detail::_typelist_type_collapsing_sum, Fn, value_type const &>)
+    requires typelist_type_invocable<Fn, value_type const &>
+  {
+    using type = detail::_typelist_type_collapsing_sum<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, true>(*this, index(), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept(
+      detail::_is_nothrow_niche_invoke<detail::_typelist_select_invoke_result, Fn, value_type &>)
+    requires typelist_invocable<Fn, value_type &> && (not typelist_type_invocable<Fn, value_type &>)
+  {
+    using type = detail::_typelist_select_invoke_result<decltype(fn), value_type &, value_type>::type;
+    return _invoke_at<type, false>(*this, index(), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept(
+      detail::_is_nothrow_niche_invoke_type<detail::_typelist_type_select_invoke_result, Fn, value_type &>)
+    requires typelist_type_invocable<Fn, value_type &>
+  {
+    using type = detail::_typelist_type_select_invoke_result<decltype(fn), value_type &, value_type>::type;
+    return _invoke_at<type, true>(*this, index(), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_niche_invoke<detail::_typelist_select_invoke_result, Fn, value_type const &>)
+    requires typelist_invocable<Fn, value_type const &> && (not typelist_type_invocable<Fn, value_type const &>)
+  {
+    using type = detail::_typelist_select_invoke_result<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, false>(*this, index(), FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_niche_invoke_type<detail::_typelist_type_select_invoke_result, Fn, value_type const &>)
+    requires typelist_type_invocable<Fn, value_type const &>
+  {
+    using type = detail::_typelist_type_select_invoke_result<decltype(fn), value_type const &, value_type>::type;
+    return _invoke_at<type, true>(*this, index(), FWD(fn));
+  }
+
+  [[nodiscard]] constexpr bool operator==(niche_sum const &) const noexcept = default;
+
+  template <typename T> static constexpr auto _encode(T const &v) noexcept -> storage_t
+  {
+    assert((std::bit_cast<storage_t>(v) & static_cast<storage_t>(niche_traits<T>::spare_bits)) == 0);
+    return static_cast<storage_t>(std::bit_cast<storage_t>(v)
+                                  | (static_cast<storage_t>(detail::type_index<T, Ts...>) << _tag_shift));
+  }
+
+  template <typename T> static constexpr auto _decode(storage_t data) noexcept -> T
+  {
+    return std::bit_cast<T>(static_cast<storage_t>(data & ~_tag_mask));
+  }
+
+  template <typename R, bool Typed, std::size_t I = 0>
+  static constexpr auto _invoke_at(auto &self, std::size_t index, auto &&fn) -> R
+  {
+    if constexpr (I + 1 < sizeof...(Ts)) {
+      if (index != I)
+        return _invoke_at<R, Typed, I + 1>(self, index, FWD(fn));
+    }
+    // NOTE The visitor is given a decoded copy, which a reference in the result would outlive
+    static_assert(not std::is_reference_v<R>, "Result of fn must not be a reference");
+    using T = select_nth<I>;
+    using V = std::conditional_t<std::is_const_v<std::remove_reference_t<decltype(self)>>, T const, T>;
+    V v = _decode<T>(self.data);
+    auto const call = [&]() -> R {
+      if constexpr (Typed)
+        return static_cast<R>(detail::_invoke(FWD(fn), std::in_place_type<T>, v));
+      else
+        return static_cast<R>(detail::_invoke(FWD(fn), v));
+    };
+    if constexpr (std::is_const_v<V>) {
+      return call();
+    } else if constexpr (std::is_void_v<R>) {
+      call();
+      self.data = _encode(v);
+    } else {
+      // NOTE The visitor may have modified the decoded copy, write it back
+      R result = call();
+      self.data = _encode(v);
+      return result;
+    }
+  }
+};
+
+template <typename... Ts> using niche_sum_for = detail::normalized<Ts...>::template apply<niche_sum>;
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_NICHE
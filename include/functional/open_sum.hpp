@@ -0,0 +1,298 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_OPEN_SUM
+#define INCLUDE_FUNCTIONAL_OPEN_SUM
+
+#include "functional/detail/functional.hpp"
+#include "functional/detail/fwd.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/detail/traits.hpp"
+#include "functional/fwd.hpp"
+#include "functional/optional.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace fn {
+
+template <typename T>
+concept some_open_sum = detail::_some_open_sum<T>;
+
+namespace detail {
+// NOTE Operations on a value of erased type, one instance for each type. The hash is nullptr for types without
+// `std::hash` specialization, and equality is nullptr for types which are not equality comparable. The key is a hash
+// of the name of the type, the same as used by `binary_format`, to tell most types apart without `std::type_info`.
+struct _open_sum_vtable final {
+  void (*copy)(void *, void const *);
+  void (*move)(void *, void *) noexcept;
+  void (*destroy)(void *) noexcept;
+  std::size_t (*hash)(void const *) noexcept;
+  bool (*equal)(void const *, void const *) noexcept;
+  std::uint64_t key;
+#if __cpp_rtti
+  std::type_info const *type;
+#endif
+};
+
+template <typename T>
+concept _open_sum_hashable = requires(T const &v) {
+  { std::hash<T>{}(v) } -> std::convertible_to<std::size_t>;
+};
+
+// NOTE The address of this object identifies the type of the value, since each specialization of a variable template
+// is a single object in the program. This does not hold across shared libraries which do not export it (e.g. built
+// with `-fvisibility=hidden`, or loaded with `RTLD_LOCAL`), where each has its own copy; see `_open_sum_same_type_info`
+template <typename T>
+constexpr _open_sum_vtable _open_sum_vtable_for = {
+    .copy = [](void *dst, void const *src) { ::new (dst) T(*static_cast<T const *>(src)); },
+    .move = [](void *dst, void *src) noexcept { ::new (dst) T(std::move(*static_cast<T *>(src))); },
+    .destroy = [](void *p) noexcept { std::destroy_at(static_cast<T *>(p)); },
+    .hash = [] {
+      if constexpr (_open_sum_hashable<T>)
+        return +[](void const *p) noexcept -> std::size_t { return std::hash<T>{}(*static_cast<T const *>(p)); };
+      else
+        return static_cast<std::size_t (*)(void const *) noexcept>(nullptr);
+    }(),
+    .equal = [] {
+      if constexpr (std::equality_comparable<T>)
+        return +[](void const *lh, void const *rh) noexcept -> bool {
+          return *static_cast<T const *>(lh) == *static_cast<T const *>(rh);
+        };
+      else
+        return static_cast<bool (*)(void const *, void const *) noexcept>(nullptr);
+    }(),
+    .key = _fnv1a(type_sortkey_v<T>),
+#if __cpp_rtti
+    .type = &typeid(T),
+#endif
+};
+
+// NOTE Fallback for vtables at different addresses, which may still belong to the same type if the value was created
+// in another shared library with its own copy of the vtable. Different types are told apart by the key, so only
+// types with the same name (or a collision of keys) are compared with `std::type_info`. Without RTTI, values created
+// in such a library are never found to hold the expected type.
+[[nodiscard]] inline bool _open_sum_same_type_info(_open_sum_vtable const *lh, _open_sum_vtable const *rh) noexcept
+{
+#if __cpp_rtti
+  return lh->key == rh->key && *lh->type == *rh->type;
+#else
+  (void)lh;
+  (void)rh;
+  return false;
+#endif
+}
+
+[[nodiscard]] inline bool _open_sum_same_type(_open_sum_vtable const *lh, _open_sum_vtable const *rh) noexcept
+{
+  return lh == rh || _open_sum_same_type_info(lh, rh);
+}
+
+template <typename T, std::size_t Size>
+concept _open_sum_fits = std::is_object_v<T> && (not std::is_const_v<T>) && (not std::is_array_v<T>) //
+                         && (not _some_open_sum<T>) && sizeof(T) <= Size && alignof(T) <= alignof(std::max_align_t)
+                         && std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>;
+} // namespace detail
+
+// NOTE Type-erased value of any type which fits in `Size` bytes of inline storage, for the cases where the set of
+// alternatives is not known upfront (e.g. at plugin boundaries) and `sum` cannot be used. Unlike `std::any`, the
+// value is never allocated on the heap; a type which does not fit is a compilation error rather than an allocation.
+// Types must be nothrow move constructible, which allows the move of `open_sum` to be noexcept.
+//
+// The value is accessed with `get_ptr<T>`, `as<T>` (yielding `fn::optional<T>`, for use in pipelines) or with
+// `invoke<Ts...>(fn)`, which calls `fn` with the value if it has one of the `Ts...` types, or with the `open_sum`
+// itself otherwise. The type is checked by comparing the address of the vtable with those of all `Ts...`, and only
+// if none is the same, with the slower fallback of `_open_sum_same_type_info` (e.g. for a value created in another
+// shared library). Similarly to `sum`, `fn` may take `std::in_place_type_t<T>` and the value. Values of different
+// types never compare equal, and neither do values of a type without `operator==`.
+template <std::size_t Size> struct open_sum final {
+  static_assert(Size >= sizeof(void *));
+
+  static constexpr std::size_t size = Size;
+  template <typename T> static constexpr bool can_hold = detail::_open_sum_fits<T, Size>;
+
+  template <typename T>
+  explicit open_sum(T &&v)
+    requires can_hold<std::remove_cvref_t<T>> && std::is_constructible_v<std::remove_cvref_t<T>, T>
+      : _vtable(&detail::_open_sum_vtable_for<std::remove_cvref_t<T>>)
+  {
+    ::new (static_cast<void *>(_data)) std::remove_cvref_t<T>(FWD(v));
+  }
+
+  template <typename T>
+  explicit open_sum(std::in_place_type_t<T>, auto &&...args)
+    requires can_hold<T> && std::is_constructible_v<T, decltype(args)...>
+      : _vtable(&detail::_open_sum_vtable_for<T>)
+  {
+    ::new (static_cast<void *>(_data)) T(FWD(args)...);
+  }
+
+  open_sum(open_sum const &other) : _vtable(other._vtable) { _vtable->copy(_data, other._data); }
+  open_sum(open_sum &&other) noexcept : _vtable(other._vtable) { _vtable->move(_data, other._data); }
+  ~open_sum() noexcept { _vtable->destroy(_data); }
+
+  // NOTE If the copy throws, the old value is left intact
+  open_sum &operator=(open_sum const &other)
+  {
+    if (this != &other)
+      *this = open_sum(other);
+    return *this;
+  }
+
+  open_sum &operator=(open_sum &&other) noexcept
+  {
+    if (this != &other) {
+      _vtable->destroy(_data);
+      _vtable = other._vtable;
+      _vtable->move(_data, other._data);
+    }
+    return *this;
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  auto emplace(auto &&...args) -> T &
+    requires std::is_constructible_v<T, decltype(args)...>
+  {
+    *this = open_sum(std::in_place_type<T>, FWD(args)...);
+    return *_get<T>();
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  [[nodiscard]] bool has_value(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return detail::_open_sum_same_type(_vtable, &detail::_open_sum_vtable_for<T>);
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  [[nodiscard]] T *get_ptr(std::in_place_type_t<T> = std::in_place_type<T>) noexcept
+  {
+    return has_value(std::in_place_type<T>) ? _get<T>() : nullptr;
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  [[nodiscard]] T const *get_ptr(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return has_value(std::in_place_type<T>) ? _get<T>() : nullptr;
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  [[nodiscard]] auto as(std::in_place_type_t<T> = std::in_place_type<T>) const & -> optional<T>
+  {
+    if (has_value(std::in_place_type<T>))
+      return {*_get<T>()};
+    return {std::nullopt};
+  }
+
+  template <typename T>
+    requires can_hold<T>
+  [[nodiscard]] auto as(std::in_place_type_t<T> = std::in_place_type<T>) && -> optional<T>
+  {
+    if (has_value(std::in_place_type<T>))
+      return {std::move(*_get<T>())};
+    return {std::nullopt};
+  }
+
+  template <typename... Ts, typename Fn>
+    requires(sizeof...(Ts) > 0) && (... && can_hold<Ts>)
+  decltype(auto) invoke(Fn &&fn) &
+  {
+    return _invoke<0, Ts...>(_find<Ts...>(), *this, FWD(fn));
+  }
+
+  template <typename... Ts, typename Fn>
+    requires(sizeof...(Ts) > 0) && (... && can_hold<Ts>)
+  decltype(auto) invoke(Fn &&fn) const &
+  {
+    return _invoke<0, Ts...>(_find<Ts...>(), *this, FWD(fn));
+  }
+
+  template <typename... Ts, typename Fn>
+    requires(sizeof...(Ts) > 0) && (... && can_hold<Ts>)
+  decltype(auto) invoke(Fn &&fn) &&
+  {
+    return _invoke<0, Ts...>(_find<Ts...>(), std::move(*this), FWD(fn));
+  }
+
+  template <typename... Ts, typename Fn>
+    requires(sizeof...(Ts) > 0) && (... && can_hold<Ts>)
+  decltype(auto) invoke(Fn &&fn) const &&
+  {
+    return _invoke<0, Ts...>(_find<Ts...>(), std::move(*this), FWD(fn));
+  }
+
+  [[nodiscard]] friend bool operator==(open_sum const &lh, open_sum const &rh) noexcept
+  {
+    return detail::_open_sum_same_type(lh._vtable, rh._vtable) && lh._vtable->equal != nullptr
+           && lh._vtable->equal(lh._data, rh._data);
+  }
+
+  // NOTE Precondition: the value has `std::hash` specialization, i.e. `hashable()` is true
+  [[nodiscard]] bool hashable() const noexcept { return _vtable->hash != nullptr; }
+  [[nodiscard]] auto hash() const noexcept -> std::size_t { return _vtable->hash(_data); }
+
+  template <typename T> [[nodiscard]] T *_get() noexcept { return std::launder(reinterpret_cast<T *>(_data)); }
+  template <typename T> [[nodiscard]] T const *_get() const noexcept
+  {
+    return std::launder(reinterpret_cast<T const *>(_data));
+  }
+
+private:
+  // NOTE Position of the type of the value in `Ts...`, or `sizeof...(Ts)` if it is none of them
+  template <typename... Ts> [[nodiscard]] auto _find() const noexcept -> std::size_t
+  {
+    std::size_t i = 0;
+    if ((... || (_vtable == &detail::_open_sum_vtable_for<Ts> || (++i, false))))
+      return i;
+    i = 0;
+    (void)(... || (detail::_open_sum_same_type_info(_vtable, &detail::_open_sum_vtable_for<Ts>) || (++i, false)));
+    return i;
+  }
+
+  template <std::size_t I, typename... Ts, typename Self, typename Fn>
+  static auto _invoke(std::size_t index, Self &&self, Fn &&fn) -> detail::_invoke_result_t<Fn, Self &&>
+  {
+    using result_t = detail::_invoke_result_t<Fn, Self &&>;
+    if constexpr (I == sizeof...(Ts)) {
+      return detail::_invoke(FWD(fn), FWD(self));
+    } else {
+      using T = detail::select_nth_t<I, Ts...>;
+      using value_t = apply_const_lvalue_t<Self, T &&>;
+      if (index == I) {
+        if constexpr (detail::_is_invocable_v<Fn, std::in_place_type_t<T>, value_t>) {
+          static_assert(std::same_as<detail::_invoke_result_t<Fn, std::in_place_type_t<T>, value_t>, result_t>);
+          return detail::_invoke(FWD(fn), std::in_place_type<T>, static_cast<value_t>(*self.template _get<T>()));
+        } else {
+          static_assert(std::same_as<detail::_invoke_result_t<Fn, value_t>, result_t>);
+          return detail::_invoke(FWD(fn), static_cast<value_t>(*self.template _get<T>()));
+        }
+      }
+      return _invoke<I + 1, Ts...>(index, FWD(self), FWD(fn));
+    }
+  }
+
+  alignas(std::max_align_t) std::byte _data[Size];
+  detail::_open_sum_vtable const *_vtable;
+};
+
+} // namespace fn
+
+template <std::size_t Size> struct std::hash<fn::open_sum<Size>> {
+  // NOTE Precondition: `v.hashable()`
+  [[nodiscard]] auto operator()(fn::open_sum<Size> const &v) const noexcept -> std::size_t { return v.hash(); }
+};
+
+#endif // INCLUDE_FUNCTIONAL_OPEN_SUM
@@ -7,6 +7,7 @@
 #define INCLUDE_FUNCTIONAL_OPTIONAL
 
 #include "functional/detail/functional.hpp"
+#include "functional/detail/pack_expr.hpp"
 #include "functional/fwd.hpp"
 #include "functional/pack.hpp"
 #include "functional/utility.hpp"
@@ -41,7 +42,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = ::fn::detail::_invoke_result_t<Fn, value_type &>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), this->value());
+      return ::fn::detail::_invoke(FWD(fn), **this);
     else
       return type(std::nullopt);
   }
@@ -51,7 +52,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = ::fn::detail::_invoke_result_t<Fn, value_type const &>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), this->value());
+      return ::fn::detail::_invoke(FWD(fn), **this);
     else
       return type(std::nullopt);
   }
@@ -61,7 +62,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = ::fn::detail::_invoke_result_t<Fn, value_type &&>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+      return ::fn::detail::_invoke(FWD(fn), std::move(**this));
     else
       return type(std::nullopt);
   }
@@ -71,7 +72,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = ::fn::detail::_invoke_result_t<Fn, value_type const &&>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return ::fn::detail::_invoke(FWD(fn), std::move(this->value()));
+      return ::fn::detail::_invoke(FWD(fn), std::move(**this));
     else
       return type(std::nullopt);
   }
@@ -83,7 +84,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = optional<T>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
       return ::fn::detail::_invoke(FWD(fn));
   }
@@ -95,7 +96,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = optional<T>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return type(std::in_place, this->value());
+      return type(std::in_place, **this);
     else
       return ::fn::detail::_invoke(FWD(fn));
   }
@@ -107,7 +108,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = optional<T>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
       return ::fn::detail::_invoke(FWD(fn));
   }
@@ -119,7 +120,7 @@ template <typename T> struct optional final : std::optional<T> {
     using type = optional<T>;
     static_assert(some_optional<type>);
     if (this->has_value())
-      return type(std::in_place, std::move(this->value()));
+      return type(std::in_place, std::move(**this));
     else
       return ::fn::detail::_invoke(FWD(fn));
   }
@@ -129,7 +130,7 @@ template <typename T> struct optional final : std::optional<T> {
     using value_type = ::fn::detail::_invoke_result_t<Fn, value_type &>;
     using type = optional<value_type>;
     if (this->has_value())
-      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), this->value()));
+      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), **this));
     else
       return type(std::nullopt);
   }
@@ -139,7 +140,7 @@ template <typename T> struct optional final : std::optional<T> {
     using value_type = ::fn::detail::_invoke_result_t<Fn, value_type const &>;
     using type = optional<value_type>;
     if (this->has_value())
-      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), this->value()));
+      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), **this));
     else
       return type(std::nullopt);
   }
@@ -149,7 +150,7 @@ template <typename T> struct optional final : std::optional<T> {
     using value_type = ::fn::detail::_invoke_result_t<Fn, value_type &&>;
     using type = optional<value_type>;
     if (this->has_value())
-      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(this->value())));
+      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(**this)));
     else
       return type(std::nullopt);
   }
@@ -159,7 +160,7 @@ template <typename T> struct optional final : std::optional<T> {
     using value_type = ::fn::detail::_invoke_result_t<Fn, value_type const &&>;
     using type = optional<value_type>;
     if (this->has_value())
-      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(this->value())));
+      return type(std::in_place, ::fn::detail::_invoke(FWD(fn), std::move(**this)));
     else
       return type(std::nullopt);
   }
@@ -167,38 +168,13 @@ template <typename T> struct optional final : std::optional<T> {
 
 template <class T> optional(T) -> optional<T>;
 
+// Producing optional<pack<...>> when the result is consumed; see detail::pack_expr for chaining more operands
 template <some_optional Lh, some_optional Rh>
-  requires(not some_pack<typename std::remove_cvref_t<Lh>::value_type>)
-          && (not some_pack<typename std::remove_cvref_t<Rh>::value_type>)
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
-{
-  using lh_type = std::remove_cvref_t<Lh>::value_type;
-  using rh_type = std::remove_cvref_t<Rh>::value_type;
-  using value_type = pack<lh_type, rh_type>;
-  using type = optional<value_type>;
-  if (lh.has_value() && rh.has_value())
-    return type{std::in_place, pack<lh_type>{FWD(lh).value()}.append(std::in_place_type_t<rh_type>{}, FWD(rh).value())};
-  else if (not lh.has_value())
-    return type{std::nullopt};
-  else
-    return type{std::nullopt};
-}
-
-template <some_optional Lh, some_optional Rh>
-  requires some_pack<typename std::remove_cvref_t<Lh>::value_type>
-           && (not some_pack<typename std::remove_cvref_t<Rh>::value_type>)
-constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept
+  requires(not some_pack<typename std::remove_cvref_t<Rh>::value_type>)
+constexpr auto operator&(Lh &&lh, Rh &&rh) noexcept(detail::_is_nothrow_pack_expr_operand<Lh>
+                                                    && detail::_is_nothrow_pack_expr_operand<Rh>)
 {
-  using lh_type = std::remove_cvref_t<Lh>::value_type;
-  using rh_type = std::remove_cvref_t<Rh>::value_type;
-  using value_type = typename lh_type::template append_type<rh_type>;
-  using type = optional<value_type>;
-  if (lh.has_value() && rh.has_value())
-    return type{std::in_place, FWD(lh).value().append(std::in_place_type_t<rh_type>{}, FWD(rh).value())};
-  else if (not lh.has_value())
-    return type{std::nullopt};
-  else
-    return type{std::nullopt};
+  return detail::pack_expr(FWD(lh), FWD(rh));
 }
 
 template <some_optional Lh, some_optional Rh>
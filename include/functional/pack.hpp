@@ -10,6 +10,11 @@
 #include "functional/fwd.hpp"
 #include "functional/utility.hpp"
 
+#include <compare>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
 namespace fn {
 
 template <typename T>
@@ -19,97 +24,53 @@ template <typename... Ts> struct pack : detail::pack_impl<std::index_sequence_fo
   using _impl = detail::pack_impl<std::index_sequence_for<Ts...>, Ts...>;
 
   template <typename Arg> using append_type = pack<Ts..., Arg>;
+};
 
-  template <typename T>
-  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) & noexcept -> append_type<T>
-    requires std::is_constructible_v<T, decltype(args)...>
-             && requires { static_cast<append_type<T>>(_impl::template _append<T>(*this, FWD(args)...)); }
-  {
-    return {_impl::template _append<T>(*this, FWD(args)...)};
-  }
-
-  template <typename T>
-  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) const & noexcept -> append_type<T>
-    requires std::is_constructible_v<T, decltype(args)...>
-             && requires { static_cast<append_type<T>>(_impl::template _append<T>(*this, FWD(args)...)); }
-  {
-    return {_impl::template _append<T>(*this, FWD(args)...)};
-  }
-
-  template <typename T>
-  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) && noexcept -> append_type<T>
-    requires std::is_constructible_v<T, decltype(args)...>
-             && requires { static_cast<append_type<T>>(_impl::template _append<T>(std::move(*this), FWD(args)...)); }
-  {
-    return {_impl::template _append<T>(std::move(*this), FWD(args)...)};
-  }
-
-  template <typename T>
-  [[nodiscard]] constexpr auto append(std::in_place_type_t<T>, auto &&...args) const && noexcept -> append_type<T>
-    requires std::is_constructible_v<T, decltype(args)...>
-             && requires { static_cast<append_type<T>>(_impl::template _append<T>(std::move(*this), FWD(args)...)); }
-  {
-    return {_impl::template _append<T>(std::move(*this), FWD(args)...)};
-  }
-
-  template <typename Arg>
-  [[nodiscard]] constexpr auto append(Arg &&arg) & noexcept -> append_type<Arg>
-    requires requires { static_cast<append_type<Arg>>(_impl::template _append<Arg>(*this, FWD(arg))); }
-  {
-    return {_impl::template _append<Arg>(*this, FWD(arg))};
-  }
-
-  template <typename Arg>
-  [[nodiscard]] constexpr auto append(Arg &&arg) const & noexcept -> append_type<Arg>
-    requires requires { static_cast<append_type<Arg>>(_impl::template _append<Arg>(*this, FWD(arg))); }
-  {
-    return {_impl::template _append<Arg>(*this, FWD(arg))};
-  }
-
-  template <typename Arg>
-  [[nodiscard]] constexpr auto append(Arg &&arg) && noexcept -> append_type<Arg>
-    requires requires { static_cast<append_type<Arg>>(_impl::template _append<Arg>(std::move(*this), FWD(arg))); }
-  {
-    return {_impl::template _append<Arg>(std::move(*this), FWD(arg))};
-  }
-
-  template <typename Arg>
-  [[nodiscard]] constexpr auto append(Arg &&arg) const && noexcept -> append_type<Arg>
-    requires requires { static_cast<append_type<Arg>>(_impl::template _append<Arg>(std::move(*this), FWD(arg))); }
-  {
-    return {_impl::template _append<Arg>(std::move(*this), FWD(arg))};
-  }
+// NOTE Pack with elements ordered in memory by alignment, selected when this is smaller than the logical order e.g.
+// `pack<char, double, char>`. It is not an aggregate, since aggregate initialization follows the memory order, but
+// the constructor takes elements in logical order and initializes them like aggregate initialization would. Unlike
+// aggregate initialization, the constructor cannot initialize an element from a prvalue without a move; `append` can,
+// as it constructs the new element in place.
+template <typename... Ts>
+  requires detail::pack_impl<std::index_sequence_for<Ts...>, Ts...>::_reordered
+struct pack<Ts...> : detail::pack_impl<std::index_sequence_for<Ts...>, Ts...> {
+  using _impl = detail::pack_impl<std::index_sequence_for<Ts...>, Ts...>;
 
-  template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) & noexcept -> decltype(auto)
-    requires requires { _impl::_invoke(*this, FWD(fn), FWD(args)...); }
-  {
-    return _impl::_invoke(*this, FWD(fn), FWD(args)...);
-  }
+  template <typename Arg> using append_type = pack<Ts..., Arg>;
 
-  template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) const & noexcept -> decltype(auto)
-    requires requires { _impl::_invoke(*this, FWD(fn), FWD(args)...); }
-  {
-    return _impl::_invoke(*this, FWD(fn), FWD(args)...);
-  }
+  constexpr pack() = default;
 
-  template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) && noexcept -> decltype(auto)
-    requires requires { _impl::_invoke(std::move(*this), FWD(fn), FWD(args)...); }
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ts)) && (... && detail::_pack_element_from<Ts, Args>)
+  constexpr pack(Args &&...args) noexcept((... && detail::_is_nothrow_pack_element_from<Ts, Args>))
+      : _impl{_impl::_storage::_make(detail::_pack_from_args<Args...>{{FWD(args)...}})}
   {
-    return _impl::_invoke(std::move(*this), FWD(fn), FWD(args)...);
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn, auto &&...args) const && noexcept -> decltype(auto)
-    requires requires { _impl::_invoke(std::move(*this), FWD(fn), FWD(args)...); }
+  constexpr pack(detail::_pack_init_tag, Fn &&fn) noexcept(noexcept(_impl::_storage::_make(FWD(fn))))
+      : _impl{_impl::_storage::_make(FWD(fn))}
   {
-    return _impl::_invoke(std::move(*this), FWD(fn), FWD(args)...);
   }
 };
 
 template <typename... Args> pack(Args &&...args) -> pack<Args...>;
+
+template <typename... Ts>
+[[nodiscard]] constexpr bool operator==(pack<Ts...> const &lh, pack<Ts...> const &rh) noexcept
+  requires(... && std::equality_comparable<Ts>)
+{
+  return pack<Ts...>::_impl::_equal(lh, rh);
+}
+
+template <typename... Ts>
+[[nodiscard]] constexpr auto operator<=>(pack<Ts...> const &lh, pack<Ts...> const &rh) noexcept
+    -> std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>
+  requires(... && std::three_way_comparable<Ts>)
+{
+  using type = std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>;
+  return pack<Ts...>::_impl::template _compare<type>(lh, rh);
+}
 } // namespace fn
 
 #endif // INCLUDE_FUNCTIONAL_PACK
@@ -49,7 +49,7 @@ struct recover_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (v.has_value()) {
-      return type{std::in_place, FWD(v).value()};
+      return type{std::in_place, *FWD(v)};
     }
     return type{std::in_place, ::fn::invoke(FWD(fn), FWD(v).error())};
   }
@@ -72,7 +72,7 @@ struct recover_t::apply final {
   {
     using type = std::remove_cvref_t<decltype(v)>;
     if (v.has_value()) {
-      return type{std::in_place, FWD(v).value()};
+      return type{std::in_place, *FWD(v)};
     }
     return type{std::in_place, ::fn::invoke(FWD(fn))};
   }
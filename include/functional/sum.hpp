@@ -6,6 +6,7 @@
 #ifndef INCLUDE_FUNCTIONAL_SUM
 #define INCLUDE_FUNCTIONAL_SUM
 
+#include "functional/box.hpp"
 #include "functional/detail/functional.hpp"
 #include "functional/detail/meta.hpp"
 #include "functional/detail/traits.hpp"
@@ -14,6 +15,17 @@
 #include "functional/fwd.hpp"
 #include "functional/utility.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -36,26 +48,72 @@ template <typename T>
 static constexpr bool _is_valid_sum_subtype //
     = (not std::is_same_v<void, T>)&&(not std::is_reference_v<T>)&&(not some_sum<T>)&&(not some_in_place_type<T>);
 
+// NOTE Special members of `sum` are trivial if they are trivial for every alternative. These concepts are
+// needed so the constraints of trivial overloads subsume the constraints of non-trivial ones.
+template <typename... Ts>
+concept _all_copy_constructible = (... && std::is_copy_constructible_v<Ts>);
+template <typename... Ts>
+concept _all_trivially_copy_constructible
+    = _all_copy_constructible<Ts...> && (... && std::is_trivially_copy_constructible_v<Ts>);
+template <typename... Ts>
+concept _all_move_constructible = (... && std::is_move_constructible_v<Ts>);
+template <typename... Ts>
+concept _all_trivially_move_constructible
+    = _all_move_constructible<Ts...> && (... && std::is_trivially_move_constructible_v<Ts>);
+template <typename... Ts>
+concept _all_copy_assignable = (... && (std::is_copy_constructible_v<Ts> && std::is_copy_assignable_v<Ts>));
+template <typename... Ts>
+concept _all_trivially_copy_assignable
+    = _all_copy_assignable<Ts...>
+      && (... && (std::is_trivially_copy_constructible_v<Ts> && std::is_trivially_copy_assignable_v<Ts>))
+      && (... && std::is_trivially_destructible_v<Ts>);
+template <typename... Ts>
+concept _all_move_assignable = (... && (std::is_move_constructible_v<Ts> && std::is_move_assignable_v<Ts>));
+template <typename... Ts>
+concept _all_trivially_move_assignable
+    = _all_move_assignable<Ts...>
+      && (... && (std::is_trivially_move_constructible_v<Ts> && std::is_trivially_move_assignable_v<Ts>))
+      && (... && std::is_trivially_destructible_v<Ts>);
+
+// NOTE Special members of `sum` are noexcept if they are noexcept for every alternative, so that e.g. `std::vector`
+// moves rather than copies the elements on reallocation. Destructors are assumed to not throw.
+template <typename... Ts>
+constexpr bool _all_nothrow_copy_constructible = (... && std::is_nothrow_copy_constructible_v<Ts>);
+template <typename... Ts>
+constexpr bool _all_nothrow_move_constructible = (... && std::is_nothrow_move_constructible_v<Ts>);
+template <typename... Ts>
+constexpr bool _all_nothrow_copy_assignable
+    = (... && (std::is_nothrow_copy_constructible_v<Ts> && std::is_nothrow_copy_assignable_v<Ts>));
+template <typename... Ts>
+constexpr bool _all_nothrow_move_assignable
+    = (... && (std::is_nothrow_move_constructible_v<Ts> && std::is_nothrow_move_assignable_v<Ts>));
+
+// NOTE Every alternative of the sum `S` can be copied (or moved, if `S` is an rvalue) without throwing
+template <typename S, typename T = std::remove_cvref_t<S>> constexpr bool _is_nothrow_sum_forward = false;
+template <typename S, typename... Ts>
+constexpr bool _is_nothrow_sum_forward<S, ::fn::sum<Ts...>>
+    = (... && std::is_nothrow_constructible_v<Ts, apply_const_lvalue_t<S, Ts &&>>);
+
 struct _invoke_autodetect_tag final {};
 
 template <typename Fn, typename Self, typename T> struct _typelist_select_invoke_result;
 template <typename Fn, typename Self, template <typename...> typename Tpl, typename... Ts>
 struct _typelist_select_invoke_result<Fn, Self, Tpl<Ts...>> {
-  using T0 = select_nth_t<0, Ts...>;
+  using T0 = _visible_t<Tpl, select_nth_t<0, Ts...>>;
   using R0 = ::fn::detail::_invoke_result_t<Fn, apply_const_lvalue_t<Self, T0>>;
-  static_assert((...
-                 && std::is_same_v<R0, typename ::fn::detail::_invoke_result_t<Fn, apply_const_lvalue_t<Self, Ts>>>));
+  static_assert((... && std::is_same_v<R0, typename ::fn::detail::_invoke_result_t<
+                                               Fn, apply_const_lvalue_t<Self, _visible_t<Tpl, Ts>>>>));
   using type = R0;
 };
 
 template <typename Fn, typename Self, typename T> struct _typelist_type_select_invoke_result;
 template <typename Fn, typename Self, template <typename...> typename Tpl, typename... Ts>
 struct _typelist_type_select_invoke_result<Fn, Self, Tpl<Ts...>> {
-  using T0 = select_nth_t<0, Ts...>;
+  using T0 = _visible_t<Tpl, select_nth_t<0, Ts...>>;
   using R0 = ::fn::detail::_invoke_result_t<Fn, std::in_place_type_t<T0>, apply_const_lvalue_t<Self, T0>>;
-  static_assert((...
-                 && std::is_same_v<R0, typename ::fn::detail::_invoke_result_t<Fn, std::in_place_type_t<Ts>,
-                                                                               apply_const_lvalue_t<Self, Ts>>>));
+  static_assert((... && std::is_same_v<R0, typename ::fn::detail::_invoke_result_t<
+                                               Fn, std::in_place_type_t<_visible_t<Tpl, Ts>>,
+                                               apply_const_lvalue_t<Self, _visible_t<Tpl, Ts>>>>));
   using type = R0;
 };
 
@@ -70,6 +128,7 @@ auto operator^(typelist<Ts...> const &, typelist<T> const &) -> typelist<Ts...,
 template <typename... Ts, typename... Us>
 auto operator^(typelist<Ts...> const &, typelist<::fn::sum<Us...>> const &) -> typelist<Ts..., Us...> const &;
 
+// NOTE Fold expression rather than recursion, so the instantiation depth does not grow with the number of types
 template <typename... Ts> using flattened = std::remove_cvref_t<decltype((typelist_v<> ^ ... ^ typelist_v<Ts>))>;
 
 template <template <typename...> typename Tpl, typename T> struct normalized;
@@ -83,15 +142,17 @@ template <typename Fn, typename Self, template <typename...> typename Tpl, typen
 struct _typelist_collapsing_sum<Fn, Self, Tpl<Ts...>> {
   using type = _collapsing_sum::normalized<
       Tpl, _collapsing_sum::flattened<
-               std::remove_cvref_t<::fn::detail::_invoke_result_t<Fn, apply_const_lvalue_t<Self, Ts>>>...>>::type;
+               std::remove_cvref_t<
+                   ::fn::detail::_invoke_result_t<Fn, apply_const_lvalue_t<Self, _visible_t<Tpl, Ts>>>>...>>::type;
 };
 
 template <typename Fn, typename Self, typename T> struct _typelist_type_collapsing_sum;
 template <typename Fn, typename Self, template <typename...> typename Tpl, typename... Ts>
 struct _typelist_type_collapsing_sum<Fn, Self, Tpl<Ts...>> {
-  using type
-      = _collapsing_sum::normalized<Tpl, _collapsing_sum::flattened<std::remove_cvref_t<::fn::detail::_invoke_result_t<
-                                             Fn, std::in_place_type_t<Ts>, apply_const_lvalue_t<Self, Ts>>>...>>::type;
+  using type = _collapsing_sum::normalized<
+      Tpl, _collapsing_sum::flattened<std::remove_cvref_t<::fn::detail::_invoke_result_t<
+               Fn, std::in_place_type_t<_visible_t<Tpl, Ts>>,
+               apply_const_lvalue_t<Self, _visible_t<Tpl, Ts>>>>...>>::type;
 };
 
 template <typename T, typename Fn, typename Self> struct _select_invoke_result final {
@@ -114,11 +175,176 @@ template <typename Fn, typename Self> struct _invoke_type_result<_collapsing_sum
   using type = _typelist_type_collapsing_sum<Fn, Self, std::remove_cvref_t<Self>>::type;
 };
 
+// NOTE Member functions `invoke`, `invoke_r` and `transform` are noexcept if `fn` does not throw for any alternative,
+// and neither does the conversion of its result to the result type (e.g. collapsed sum, for `transform`)
+template <typename T, typename Fn, typename Self>
+constexpr bool _is_nothrow_select_invoke
+    = _is_nothrow_rts_invocable<typename _select_invoke_result<T, Fn, Self>::type, Fn, Self>;
+template <typename T, typename Fn, typename Self>
+constexpr bool _is_nothrow_invoke_type
+    = _is_nothrow_rtst_invocable<typename _invoke_type_result<T, Fn, Self>::type, Fn, Self>;
+
+// NOTE Visitation of several sums at once, with a single dispatch on the combined index of all sums, i.e. the index
+// of the first sum is the most significant "digit". The function is called either with values only, or with
+// `std::in_place_type_t` tags for all values, followed by the values.
+template <typename... Ss> constexpr std::size_t _invoke_sums_size = (1 * ... * std::remove_cvref_t<Ss>::size);
+
+template <std::size_t K, typename... Ss> constexpr std::size_t _invoke_sums_stride = [] {
+  constexpr std::size_t sizes[] = {std::remove_cvref_t<Ss>::size...};
+  std::size_t result = 1;
+  for (std::size_t i = K + 1; i < sizeof...(Ss); ++i)
+    result *= sizes[i];
+  return result;
+}();
+
+template <std::size_t I, std::size_t K, typename... Ss>
+using _invoke_sums_nth_t = typename std::remove_cvref_t<select_nth_t<K, Ss...>>::template select_nth<
+    (I / _invoke_sums_stride<K, Ss...>) % std::remove_cvref_t<select_nth_t<K, Ss...>>::size>;
+
+template <typename Fn, typename Is, typename Ks, typename... Ss> struct _invoke_sums_traits;
+template <typename Fn, std::size_t... Is, std::size_t... Ks, typename... Ss>
+struct _invoke_sums_traits<Fn, std::index_sequence<Is...>, std::index_sequence<Ks...>, Ss...> final {
+  template <std::size_t I, std::size_t K> using nth = _invoke_sums_nth_t<I, K, Ss...>;
+  template <std::size_t I, std::size_t K, typename S> using arg = apply_const_lvalue_t<S, nth<I, K> &&>;
+
+  template <std::size_t I> static constexpr bool invocable = _is_invocable_v<Fn, arg<I, Ks, Ss>...>;
+  template <std::size_t I>
+  static constexpr bool type_invocable = _is_invocable_v<Fn, std::in_place_type_t<nth<I, Ks>>..., arg<I, Ks, Ss>...>;
+
+  static constexpr bool typed = (... && type_invocable<Is>);
+  static constexpr bool value = typed || (... && invocable<Is>);
+
+  template <std::size_t I> static constexpr bool nothrow_invocable = [] {
+    if constexpr (typed)
+      return _is_nothrow_invocable_v<Fn, std::in_place_type_t<nth<I, Ks>>..., arg<I, Ks, Ss>...>;
+    else
+      return _is_nothrow_invocable_v<Fn, arg<I, Ks, Ss>...>;
+  }();
+  static constexpr bool nothrow = (... && nothrow_invocable<Is>);
+
+  template <std::size_t I> static constexpr auto result()
+  {
+    if constexpr (typed)
+      return std::type_identity<_invoke_result_t<Fn, std::in_place_type_t<nth<I, Ks>>..., arg<I, Ks, Ss>...>>{};
+    else
+      return std::type_identity<_invoke_result_t<Fn, arg<I, Ks, Ss>...>>{};
+  }
+  template <std::size_t I> using result_t = typename decltype(result<I>())::type;
+};
+
+template <typename Fn, typename... Ss>
+using _invoke_sums_traits_t = _invoke_sums_traits<Fn, std::make_index_sequence<_invoke_sums_size<Ss...>>,
+                                                  std::index_sequence_for<Ss...>, Ss...>;
+
+template <typename T, typename Traits, typename Is> struct _invoke_sums_result final {
+  using type = T;
+};
+template <typename Traits, std::size_t I0, std::size_t... Is>
+struct _invoke_sums_result<_invoke_autodetect_tag, Traits, std::index_sequence<I0, Is...>> final {
+  using R0 = typename Traits::template result_t<I0>;
+  static_assert((... && std::is_same_v<R0, typename Traits::template result_t<Is>>));
+  using type = R0;
+};
+
+template <std::size_t I, std::size_t K, typename... Ss>
+constexpr auto _invoke_sums_value(auto &&s) noexcept
+    -> apply_const_lvalue_t<decltype(s), _invoke_sums_nth_t<I, K, Ss...> &&>
+{
+  using type = _invoke_sums_nth_t<I, K, Ss...>;
+  using data_t = typename std::remove_cvref_t<decltype(s)>::data_t;
+  return static_cast<apply_const_lvalue_t<decltype(s), type &&>>(*ptr_variadic_union<type, data_t>(s.data));
+}
+
+template <std::size_t I, typename R, bool Typed, typename Fn, typename... Ss>
+constexpr auto _invoke_sums_nth(Fn &&fn, Ss &&...s) -> R
+{
+  return [&]<std::size_t... Ks>(std::index_sequence<Ks...>) -> R {
+    if constexpr (Typed)
+      return static_cast<R>(_invoke(FWD(fn), std::in_place_type<_invoke_sums_nth_t<I, Ks, Ss...>>...,
+                                    _invoke_sums_value<I, Ks, Ss...>(static_cast<Ss &&>(s))...));
+    else
+      return static_cast<R>(_invoke(FWD(fn), _invoke_sums_value<I, Ks, Ss...>(static_cast<Ss &&>(s))...));
+  }(std::index_sequence_for<Ss...>{});
+}
+
+template <typename R, bool Typed, typename Fn, typename Is, typename... Ss> struct _invoke_sums_table;
+template <typename R, bool Typed, typename Fn, std::size_t... Is, typename... Ss>
+struct _invoke_sums_table<R, Typed, Fn, std::index_sequence<Is...>, Ss...> final {
+  static constexpr R (*value[])(Fn &&, Ss &&...) = {&_invoke_sums_nth<Is, R, Typed, Fn, Ss...>...};
+};
+
+template <std::size_t I, std::size_t N, typename R, bool Typed, typename Fn, typename... Ss>
+constexpr auto _invoke_sums_chain(std::size_t index, Fn &&fn, Ss &&...s) -> R
+{
+  if constexpr (I + 1 == N) {
+    return _invoke_sums_nth<I, R, Typed, Fn, Ss...>(FWD(fn), FWD(s)...);
+  } else {
+    if (index == I)
+      return _invoke_sums_nth<I, R, Typed, Fn, Ss...>(FWD(fn), FWD(s)...);
+    return _invoke_sums_chain<I + 1, N, R, Typed, Fn, Ss...>(index, FWD(fn), FWD(s)...);
+  }
+}
+
+// NOTE Similarly to invoke_variadic_union, small number of combinations is dispatched with a chain of comparisons
+template <typename T = _invoke_autodetect_tag, typename Tag = _invoke_autodetect_tag, typename Fn, typename... Ss>
+[[nodiscard]] constexpr auto _invoke_sums(Fn &&fn, Ss &&...s) noexcept(_invoke_sums_traits_t<Fn, Ss...>::nothrow)
+  requires _some_sums<Ss...> && _invoke_sums_traits_t<Fn, Ss...>::value
+{
+  using traits = _invoke_sums_traits_t<Fn, Ss...>;
+  using is = std::make_index_sequence<_invoke_sums_size<Ss...>>;
+  using type = _invoke_sums_result<T, traits, is>::type;
+  std::size_t const index = [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+    return (0 + ... + (static_cast<std::size_t>(s.index) * _invoke_sums_stride<Ks, Ss...>));
+  }(std::index_sequence_for<Ss...>{});
+  constexpr bool use_table = std::is_same_v<Tag, _invoke_autodetect_tag>
+                                 ? (_invoke_sums_size<Ss...> > _invoke_table_threshold)
+                                 : std::is_same_v<Tag, _invoke_table_tag>;
+  if constexpr (use_table) {
+    using table = _invoke_sums_table<type, traits::typed, Fn, is, Ss...>;
+    return table::value[index](FWD(fn), FWD(s)...);
+  } else {
+    constexpr std::size_t size = _invoke_sums_size<Ss...>;
+    return _invoke_sums_chain<0, size, type, traits::typed, Fn, Ss...>(index, FWD(fn), FWD(s)...);
+  }
+}
+
+// NOTE Construct an alternative with braces, the same as `make_variadic_union` does for the constructors of `sum`.
+// Placement new is not allowed in constant evaluation, where the alternative is moved from a temporary instead.
+template <typename T> constexpr auto _construct_alternative(T *ptr, auto &&...args) noexcept(noexcept(T{FWD(args)...}))
+    -> T *
+{
+  if constexpr (std::is_move_constructible_v<T>) {
+    if consteval {
+      return std::construct_at(ptr, T{FWD(args)...});
+    }
+  }
+  return ::new (static_cast<void *>(ptr)) T{FWD(args)...};
+}
+
+// NOTE Copy the object representation of a variadic_union into a superset, where the same alternative is also stored
+// at offset 0. Both must be trivially copyable. The bytes past the end of `V` are zeroed rather than left
+// indeterminate, since they become the representation of `U`.
+template <typename U, typename V> [[nodiscard]] auto _copy_variadic_union(V const &v) noexcept -> U
+{
+  static_assert(sizeof(V) <= sizeof(U));
+  std::array<std::byte, sizeof(U)> buffer{};
+  std::memcpy(buffer.data(), &v, sizeof(V));
+  return std::bit_cast<U>(buffer);
+}
+
 } // namespace detail
 
 template <typename... Ts> struct sum;
 template <> struct sum<>; // Intentionally incomplete
 
+// NOTE Type of the discriminator stored in `sum`. By default this is the smallest unsigned type able to
+// represent the index of every alternative; users may specialize it for a given `sum_for<...>` e.g. to
+// keep a stable binary layout as the list of alternatives grows.
+template <typename T> struct sum_index;
+template <typename... Ts> struct sum_index<sum<Ts...>> {
+  using type = detail::select_index_t<sizeof...(Ts)>;
+};
+
 template <typename... Ts>
   requires(sizeof...(Ts) > 0)
 struct sum<Ts...> {
@@ -126,15 +352,19 @@ struct sum<Ts...> {
   static_assert(std::same_as<typename detail::normalized<Ts...>::template apply<::fn::sum>, sum>);
 
   using data_t = detail::variadic_union<Ts...>;
+  using index_t = typename sum_index<sum>::type;
+  static_assert(std::is_unsigned_v<index_t> && std::numeric_limits<index_t>::max() >= sizeof...(Ts) - 1);
+
   data_t data;
-  std::size_t index;
+  index_t index;
 
   static constexpr std::size_t size = sizeof...(Ts);
   template <std::size_t I> using select_nth = detail::select_nth_t<I, Ts...>;
   template <typename T> static constexpr bool has_type = data_t::template has_type<T>;
+  static constexpr bool _has_box = detail::_has_box<Ts...>;
 
   template <typename T>
-  constexpr sum(T &&v)
+  constexpr sum(T &&v) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
     requires has_type<std::remove_cvref_t<T>> && (std::is_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
                  && (std::is_convertible_v<decltype(v), std::remove_cvref_t<T>>)
       : data(detail::make_variadic_union<std::remove_cvref_t<T>, data_t>(FWD(v))),
@@ -143,7 +373,7 @@ struct sum<Ts...> {
   }
 
   template <typename T>
-  constexpr explicit sum(T &&v)
+  constexpr explicit sum(T &&v) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
     requires has_type<std::remove_cvref_t<T>> && (std::is_constructible_v<std::remove_cvref_t<T>, decltype(v)>)
                  && (not std::is_convertible_v<decltype(v), std::remove_cvref_t<T>>)
       : data(detail::make_variadic_union<std::remove_cvref_t<T>, data_t>(FWD(v))),
@@ -152,52 +382,65 @@ struct sum<Ts...> {
   }
 
   template <typename T>
-  constexpr sum(std::in_place_type_t<T>, auto &&...args)
+  constexpr sum(std::in_place_type_t<T>, auto &&...args) noexcept(std::is_nothrow_constructible_v<T, decltype(args)...>)
     requires has_type<T>
       : data(detail::make_variadic_union<T, data_t>(FWD(args)...)), index(detail::type_index<T, Ts...>)
   {
   }
 
   template <typename... Tx>
-  constexpr sum(sum<Tx...> const &arg) noexcept
+  constexpr sum(sum<Tx...> const &arg) noexcept(detail::_all_nothrow_copy_constructible<Tx...>)
     requires detail::is_superset_of<sum, sum<Tx...>>
                  && (not std::is_same_v<sum, sum<Tx...>>) && (... && std::is_copy_constructible_v<Tx>)
-      : data(FWD(arg).template invoke_r<data_t>([]<typename T>(std::in_place_type_t<T>, auto &&v) {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
-        })),
-        index(FWD(arg).template invoke_r<std::size_t>([]<typename T>(std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+      : data(_convert_data(FWD(arg))), index(_convert_index<Tx...>[arg.index])
   {
   }
 
   template <typename... Tx>
-  constexpr sum(sum<Tx...> &&arg) noexcept
+  constexpr sum(sum<Tx...> &&arg) noexcept(detail::_all_nothrow_move_constructible<Tx...>)
     requires detail::is_superset_of<sum, sum<Tx...>>
                  && (not std::is_same_v<sum, sum<Tx...>>) && (... && std::is_move_constructible_v<Tx>)
-      : data(FWD(arg).template invoke_r<data_t>([]<typename T>(std::in_place_type_t<T>, auto &&v) {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
-        })),
-        index(FWD(arg).template invoke_r<std::size_t>([]<typename T>(std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+      : data(_convert_data(FWD(arg))), index(_convert_index<Tx...>[arg.index])
   {
   }
 
   template <typename... Tx>
-  constexpr sum(std::in_place_type_t<sum<Tx...>>, some_sum auto &&arg) noexcept
+  constexpr sum(std::in_place_type_t<sum<Tx...>>, some_sum auto &&arg) noexcept(
+      detail::_is_nothrow_sum_forward<decltype(arg)>)
     requires std::is_same_v<std::remove_cvref_t<decltype(arg)>, sum<Tx...>> && detail::is_superset_of<sum, sum<Tx...>>
-      : data(FWD(arg).template invoke_r<data_t>([]<typename T>(std::in_place_type_t<T>, auto &&v) {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
-        })),
-        index(FWD(arg).template invoke_r<std::size_t>([]<typename T>(std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+      : data(_convert_data(FWD(arg))), index(_convert_index<Tx...>[arg.index])
+  {
+  }
+
+  // NOTE Conversion from a subset, used by the constructors above. The index of every source alternative in this sum
+  // is precomputed, so only the value is dispatched on; if all alternatives are trivially copyable, the value is not
+  // dispatched on either, since every alternative is stored at offset 0 of `data`
+  template <typename... Tx>
+  static constexpr std::array<index_t, sizeof...(Tx)> _convert_index = {
+      static_cast<index_t>(detail::type_index<Tx, Ts...>)...};
+
+  template <typename Arg>
+  [[nodiscard]] static constexpr auto _convert_data(Arg &&arg) noexcept(detail::_is_nothrow_sum_forward<Arg &&>)
+      -> data_t
   {
+    if constexpr ((... && std::is_trivially_copyable_v<Ts>)) {
+      if !consteval {
+        return detail::_copy_variadic_union<data_t>(arg.data);
+      }
+    }
+    using source_t = typename std::remove_cvref_t<Arg>::data_t;
+    return detail::invoke_variadic_union<data_t, source_t>( //
+        FWD(arg).data, arg.index, []<typename T>(std::in_place_type_t<T>, auto &&v) {
+          return detail::make_variadic_union<T, data_t>(FWD(v));
+        });
   }
 
   constexpr sum(sum const &other) noexcept
-    requires(... && std::is_copy_constructible_v<Ts>)
+    requires detail::_all_trivially_copy_constructible<Ts...>
+  = default;
+
+  constexpr sum(sum const &other) noexcept(detail::_all_nothrow_copy_constructible<Ts...>)
+    requires detail::_all_copy_constructible<Ts...>
       : data(detail::invoke_variadic_union<data_t, data_t>(        //
           other.data, other.index,                                 //
           []<typename T>(std::in_place_type_t<T>, auto const &v) { //
@@ -208,7 +451,11 @@ struct sum<Ts...> {
   }
 
   constexpr sum(sum &&other) noexcept
-    requires(... && std::is_move_constructible_v<Ts>)
+    requires detail::_all_trivially_move_constructible<Ts...>
+  = default;
+
+  constexpr sum(sum &&other) noexcept(detail::_all_nothrow_move_constructible<Ts...>)
+    requires detail::_all_move_constructible<Ts...>
       : data(detail::invoke_variadic_union<data_t, data_t>(   //
           std::move(other).data, other.index,                 //
           []<typename T>(std::in_place_type_t<T>, auto &&v) { //
@@ -218,6 +465,10 @@ struct sum<Ts...> {
   {
   }
 
+  constexpr ~sum() noexcept
+    requires(... && std::is_trivially_destructible_v<Ts>)
+  = default;
+
   constexpr ~sum() noexcept
   {
     detail::invoke_variadic_union<void, data_t>( //
@@ -226,12 +477,77 @@ struct sum<Ts...> {
         });
   }
 
+  constexpr sum &operator=(sum const &other) noexcept
+    requires detail::_all_trivially_copy_assignable<Ts...>
+  = default;
+
+  // NOTE If both hold the same alternative, assign it directly so e.g. the buffer of a string can be reused
+  constexpr sum &operator=(sum const &other) noexcept(detail::_all_nothrow_copy_assignable<Ts...>)
+    requires detail::_all_copy_assignable<Ts...>
+  {
+    detail::invoke_variadic_union<void, data_t>( //
+        other.data, other.index, [this]<typename T>(std::in_place_type_t<T>, auto const &v) {
+          if (this->index == detail::type_index<T, Ts...>)
+            *detail::ptr_variadic_union<T, data_t>(this->data) = v;
+          else
+            this->template emplace<T>(T(v)); // NOTE `v` may be owned by the current value, e.g. inside a `box`
+        });
+    return *this;
+  }
+
+  constexpr sum &operator=(sum &&other) noexcept
+    requires detail::_all_trivially_move_assignable<Ts...>
+  = default;
+
+  constexpr sum &operator=(sum &&other) noexcept(detail::_all_nothrow_move_assignable<Ts...>)
+    requires detail::_all_move_assignable<Ts...>
+  {
+    detail::invoke_variadic_union<void, data_t>( //
+        std::move(other).data, other.index, [this]<typename T>(std::in_place_type_t<T>, auto &&v) {
+          if (this->index == detail::type_index<T, Ts...>)
+            *detail::ptr_variadic_union<T, data_t>(this->data) = std::move(v);
+          else
+            this->template emplace<T>(T(std::move(v)));
+        });
+    return *this;
+  }
+
+  // NOTE Unlike assignment, always destroys the current value before constructing a new one in its place, with braces
+  // like the constructors of `sum` (so e.g. `emplace<std::vector<int>>(3, 1)` holds `{3, 1}`). If the
+  // construction may throw, the new value is constructed in a temporary first, so the old value is left intact if it
+  // does; this is not possible if the move may throw as well, which is then fatal, since `sum` is never empty.
+  template <typename T>
+  constexpr T &emplace(auto &&...args) noexcept(std::is_nothrow_constructible_v<T, decltype(args)...>)
+    requires has_type<T> && (std::is_constructible_v<T, decltype(args)...>)
+  {
+    if constexpr (std::is_nothrow_constructible_v<T, decltype(args)...>) {
+      return _emplace<T>(FWD(args)...);
+    } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+      T tmp{FWD(args)...};
+      return _emplace<T>(std::move(tmp));
+    } else {
+      return [&]() noexcept -> T & { return _emplace<T>(FWD(args)...); }();
+    }
+  }
+
+  template <typename T> constexpr T &_emplace(auto &&...args) noexcept
+  {
+    if constexpr (not(... && std::is_trivially_destructible_v<Ts>)) {
+      detail::invoke_variadic_union<void, data_t>( //
+          this->data, index, [this]<typename U>(std::in_place_type_t<U>, auto &&) {
+            std::destroy_at(detail::ptr_variadic_union<U, data_t>(this->data));
+          });
+    }
+    T *const ptr = detail::_construct_alternative(detail::ptr_variadic_union<T, data_t>(this->data), FWD(args)...);
+    index = detail::type_index<T, Ts...>;
+    return *ptr;
+  }
+
   template <typename T>
     requires has_type<T>
   [[nodiscard]] constexpr bool has_value(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
   {
-    return invoke_r<bool>(
-        []<typename U>(std::in_place_type_t<U>, auto &&) constexpr -> bool { return std::is_same_v<T, U>; });
+    return index == detail::type_index<T, Ts...>;
   }
 
   template <typename T>
@@ -248,196 +564,278 @@ struct sum<Ts...> {
     return has_value(std::in_place_type<T>) ? detail::ptr_variadic_union<T, data_t>(data) : nullptr;
   }
 
+  // NOTE Construct the alternative at position `i` from its object representation, e.g. as stored by `binary_format`
+  // Precondition: i < size and bytes.size() >= sizeof(select_nth<i>)
+  [[nodiscard]] static constexpr auto from_index(std::size_t i, std::span<std::byte const> bytes) noexcept -> sum
+    requires(... && std::is_trivially_copyable_v<Ts>)
+  {
+    constexpr std::array<std::size_t, size> sizes{sizeof(Ts)...};
+    assert(i < size && bytes.size() >= sizes[i]);
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      constexpr std::array<sum (*)(std::byte const *) noexcept, size> table{&_from_bytes<Is>...};
+      return table[i](bytes.data());
+    }(std::make_index_sequence<size>{});
+  }
+
+  template <std::size_t I> static constexpr auto _from_bytes(std::byte const *bytes) noexcept -> sum
+  {
+    using type = select_nth<I>;
+    std::array<std::byte, sizeof(type)> buffer;
+    std::copy_n(bytes, sizeof(type), buffer.begin());
+    return sum{std::in_place_type<type>, std::bit_cast<type>(buffer)};
+  }
+
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, sum &>)
     requires typelist_invocable<Fn, sum &> && (not typelist_type_invocable<Fn, sum &>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, sum &>)
     requires typelist_type_invocable<Fn, sum &>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, sum const &>)
     requires typelist_invocable<Fn, sum const &> && (not typelist_type_invocable<Fn, sum const &>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, sum const &>)
     requires typelist_type_invocable<Fn, sum const &>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, sum &&>)
     requires typelist_invocable<Fn, sum &&> && (not typelist_type_invocable<Fn, sum &&>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, sum &&>)
     requires typelist_type_invocable<Fn, sum &&>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_collapsing_sum_tag, Fn, sum const &&>)
     requires typelist_invocable<Fn, sum const &&> && (not typelist_type_invocable<Fn, sum const &&>)
   {
     using type = detail::_select_invoke_result<detail::_collapsing_sum_tag, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto transform(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_collapsing_sum_tag, Fn, sum const &&>)
     requires typelist_type_invocable<Fn, sum const &&>
   {
     using type = detail::_invoke_type_result<detail::_collapsing_sum_tag, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_invoke_autodetect_tag, Fn, sum &>)
     requires typelist_invocable<Fn, sum &> && (not typelist_type_invocable<Fn, sum &>)
   {
     using type = detail::_select_invoke_result<detail::_invoke_autodetect_tag, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_invoke_autodetect_tag, Fn, sum &>)
     requires typelist_type_invocable<Fn, sum &>
   {
     using type = detail::_invoke_type_result<detail::_invoke_autodetect_tag, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_select_invoke<detail::_invoke_autodetect_tag, Fn, sum const &>)
     requires typelist_invocable<Fn, sum const &> && (not typelist_type_invocable<Fn, sum const &>)
   {
     using type = detail::_select_invoke_result<detail::_invoke_autodetect_tag, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const & noexcept(
+      detail::_is_nothrow_invoke_type<detail::_invoke_autodetect_tag, Fn, sum const &>)
     requires typelist_type_invocable<Fn, sum const &>
   {
     using type = detail::_invoke_type_result<detail::_invoke_autodetect_tag, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_invoke_autodetect_tag, Fn, sum &&>)
     requires typelist_invocable<Fn, sum &&> && (not typelist_type_invocable<Fn, sum &&>)
   {
     using type = detail::_select_invoke_result<detail::_invoke_autodetect_tag, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_invoke_autodetect_tag, Fn, sum &&>)
     requires typelist_type_invocable<Fn, sum &&>
   {
     using type = detail::_invoke_type_result<detail::_invoke_autodetect_tag, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_select_invoke<detail::_invoke_autodetect_tag, Fn, sum const &&>)
     requires typelist_invocable<Fn, sum const &&> && (not typelist_type_invocable<Fn, sum const &&>)
   {
     using type = detail::_select_invoke_result<detail::_invoke_autodetect_tag, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename Fn>
-  [[nodiscard]] constexpr auto invoke(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto invoke(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_invoke_type<detail::_invoke_autodetect_tag, Fn, sum const &&>)
     requires typelist_type_invocable<Fn, sum const &&>
   {
     using type = detail::_invoke_type_result<detail::_invoke_autodetect_tag, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) & noexcept(detail::_is_nothrow_select_invoke<T, Fn, sum &>)
     requires typelist_invocable<Fn, sum &> && (not typelist_type_invocable<Fn, sum &>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) & noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) & noexcept(detail::_is_nothrow_invoke_type<T, Fn, sum &>)
     requires typelist_type_invocable<Fn, sum &>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), sum &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const & noexcept(detail::_is_nothrow_select_invoke<T, Fn, sum const &>)
     requires typelist_invocable<Fn, sum const &> && (not typelist_type_invocable<Fn, sum const &>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const & noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const & noexcept(detail::_is_nothrow_invoke_type<T, Fn, sum const &>)
     requires typelist_type_invocable<Fn, sum const &>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), sum const &>::type;
-    return detail::invoke_variadic_union<type, data_t>(this->data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(this->data, index, detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) && noexcept(detail::_is_nothrow_select_invoke<T, Fn, sum &&>)
     requires typelist_invocable<Fn, sum &&> && (not typelist_type_invocable<Fn, sum &&>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) && noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) && noexcept(detail::_is_nothrow_invoke_type<T, Fn, sum &&>)
     requires typelist_type_invocable<Fn, sum &&>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), sum &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const && noexcept(
+      detail::_is_nothrow_select_invoke<T, Fn, sum const &&>)
     requires typelist_invocable<Fn, sum const &&> && (not typelist_type_invocable<Fn, sum const &&>)
   {
     using type = detail::_select_invoke_result<T, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
   }
 
   template <typename T, typename Fn>
-  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const && noexcept
+  [[nodiscard]] constexpr auto invoke_r(Fn &&fn) const && noexcept(detail::_is_nothrow_invoke_type<T, Fn, sum const &&>)
     requires typelist_type_invocable<Fn, sum const &&>
   {
     using type = detail::_invoke_type_result<T, decltype(fn), sum const &&>::type;
-    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index, FWD(fn));
+    return detail::invoke_variadic_union<type, data_t>(std::move(*this).data, index,
+                                                       detail::_unboxing<_has_box>(FWD(fn)));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke_with(Fn &&fn, some_sum auto &&...others) & noexcept(
+      detail::_invoke_sums_traits_t<Fn, sum &, decltype(others)...>::nothrow)
+    requires(sizeof...(others) > 0) && detail::_invoke_sums_traits_t<Fn, sum &, decltype(others)...>::value
+  {
+    return detail::_invoke_sums(FWD(fn), *this, FWD(others)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke_with(Fn &&fn, some_sum auto &&...others) const & noexcept(
+      detail::_invoke_sums_traits_t<Fn, sum const &, decltype(others)...>::nothrow)
+    requires(sizeof...(others) > 0) && detail::_invoke_sums_traits_t<Fn, sum const &, decltype(others)...>::value
+  {
+    return detail::_invoke_sums(FWD(fn), *this, FWD(others)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke_with(Fn &&fn, some_sum auto &&...others) && noexcept(
+      detail::_invoke_sums_traits_t<Fn, sum &&, decltype(others)...>::nothrow)
+    requires(sizeof...(others) > 0) && detail::_invoke_sums_traits_t<Fn, sum &&, decltype(others)...>::value
+  {
+    return detail::_invoke_sums(FWD(fn), std::move(*this), FWD(others)...);
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke_with(Fn &&fn, some_sum auto &&...others) const && noexcept(
+      detail::_invoke_sums_traits_t<Fn, sum const &&, decltype(others)...>::nothrow)
+    requires(sizeof...(others) > 0) && detail::_invoke_sums_traits_t<Fn, sum const &&, decltype(others)...>::value
+  {
+    return detail::_invoke_sums(FWD(fn), std::move(*this), FWD(others)...);
   }
 };
 
@@ -445,17 +843,54 @@ struct sum<Ts...> {
 template <typename T> explicit sum(std::in_place_type_t<T>, auto &&...) -> sum<T>;
 template <typename T> explicit sum(T) -> sum<T>;
 
-template <typename... Ts, typename... Tx>
-[[nodiscard]] constexpr bool operator==(sum<Ts...> const &lh, sum<Tx...> const &rh) noexcept
-  requires(... && (std::equality_comparable<Ts> || not detail::type_one_of<Ts, Tx...>))
+// NOTE Visit several sums with a single dispatch, see also sum::invoke_with
+template <typename Fn, typename... Ss>
+[[nodiscard]] constexpr auto invoke(Fn &&fn, Ss &&...s) noexcept(detail::_invoke_sums_traits_t<Fn, Ss...>::nothrow)
+  requires detail::_some_sums<Ss...> && detail::_invoke_sums_traits_t<Fn, Ss...>::value
 {
-  return lh.template invoke_r<bool>([&rh]<typename T>(std::in_place_type_t<T> d, auto const &lh) noexcept {
-    if constexpr (std::remove_cvref_t<decltype(rh)>::template has_type<T>) {
-      return rh.has_value(d) && lh == *rh.get_ptr(d); // GCOVR_EXCL_BR_LINE
+  return detail::_invoke_sums(FWD(fn), FWD(s)...);
+}
+
+namespace detail {
+struct _equal_sums final {
+  template <typename T, typename U>
+  static constexpr bool operator()(std::in_place_type_t<T>, std::in_place_type_t<U>, auto const &lh,
+                                   auto const &rh) noexcept
+  {
+    if constexpr (std::is_same_v<T, U>) {
+      return lh == rh;
     } else {
       return false;
     }
-  });
+  }
+};
+
+// NOTE Flattened dispatch instantiates every combination of alternatives, so for large sums only the left side is
+// dispatched and the right side is checked for holding the same alternative
+template <typename... Ts, typename... Tx>
+constexpr bool _equal_sums_dispatch(sum<Ts...> const &lh, sum<Tx...> const &rh) noexcept
+{
+  if constexpr (sizeof...(Ts) * sizeof...(Tx) <= _invoke_table_threshold) {
+    return _invoke_sums<bool>(_equal_sums{}, lh, rh);
+  } else {
+    return invoke_variadic_union<bool, typename sum<Ts...>::data_t>( //
+        lh.data, lh.index, [&rh]<typename T>(std::in_place_type_t<T>, auto const &lh) noexcept -> bool {
+          if constexpr (type_one_of<T, Tx...>) {
+            return rh.index == type_index<T, Tx...>
+                   && lh == *ptr_variadic_union<T, typename sum<Tx...>::data_t>(rh.data);
+          } else {
+            return false;
+          }
+        });
+  }
+}
+} // namespace detail
+
+template <typename... Ts, typename... Tx>
+[[nodiscard]] constexpr bool operator==(sum<Ts...> const &lh, sum<Tx...> const &rh) noexcept
+  requires(... && (std::equality_comparable<Ts> || not detail::type_one_of<Ts, Tx...>))
+{
+  return detail::_equal_sums_dispatch(lh, rh);
 }
 
 template <typename... Ts, typename... Tx>
@@ -465,6 +900,23 @@ template <typename... Ts, typename... Tx>
   return not(lh == rh);
 }
 
+// NOTE Alternatives are ordered by their position in the normalized list of types, i.e. by `index`, and values of
+// the same alternative are ordered by their own `operator<=>`
+template <typename... Ts>
+[[nodiscard]] constexpr auto operator<=>(sum<Ts...> const &lh, sum<Ts...> const &rh) noexcept
+    -> std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>
+  requires(... && std::three_way_comparable<Ts>)
+{
+  using type = std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>;
+  if (lh.index != rh.index)
+    return lh.index <=> rh.index;
+  using data_t = typename sum<Ts...>::data_t;
+  return detail::invoke_variadic_union<type, data_t>( //
+      lh.data, lh.index, [&rh]<typename T>(std::in_place_type_t<T>, auto const &lh) noexcept -> type {
+        return lh <=> *detail::ptr_variadic_union<T, data_t>(rh.data);
+      });
+}
+
 template <typename... Ts> using sum_for = detail::normalized<Ts...>::template apply<sum>;
 
 } // namespace fn
@@ -0,0 +1,367 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_SUM_VECTOR
+#define INCLUDE_FUNCTIONAL_SUM_VECTOR
+
+#include "functional/detail/functional.hpp"
+#include "functional/detail/meta.hpp"
+#include "functional/detail/variadic_union.hpp"
+#include "functional/functional.hpp"
+#include "functional/fwd.hpp"
+#include "functional/sum.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fn {
+namespace detail {
+// NOTE Member functions `invoke` and `transform` are noexcept if `fn` does not throw for any alternative, and neither
+// does the conversion of its result to the result type, same as for `sum`
+template <template <typename, typename, typename> typename Result, typename Fn, typename Self>
+constexpr bool _is_nothrow_sum_vector_invoke = _is_nothrow_rts_invocable<
+    typename Result<Fn, Self, typename std::remove_cvref_t<Self>::value_type>::type, Fn, Self>;
+template <template <typename, typename, typename> typename Result, typename Fn, typename Self>
+constexpr bool _is_nothrow_sum_vector_invoke_type = _is_nothrow_rtst_invocable<
+    typename Result<Fn, Self, typename std::remove_cvref_t<Self>::value_type>::type, Fn, Self>;
+
+// NOTE Column of `bool`, since `std::vector<bool>` is a bitset, which has neither `bool &` to its elements nor
+// contiguous storage for `std::span<bool>`. Only the operations used by `sum_vector` are provided.
+struct _bool_column final {
+  constexpr _bool_column() noexcept = default;
+  constexpr _bool_column(_bool_column const &other) : _bool_column()
+  {
+    reserve(other._size);
+    _copy(other._data, other._size, _data);
+    _size = other._size;
+  }
+  constexpr _bool_column(_bool_column &&other) noexcept
+      : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)),
+        _capacity(std::exchange(other._capacity, 0))
+  {
+  }
+  constexpr ~_bool_column() noexcept { _free(_data, _capacity); }
+
+  constexpr _bool_column &operator=(_bool_column const &other)
+  {
+    if (this != &other)
+      *this = _bool_column(other);
+    return *this;
+  }
+
+  constexpr _bool_column &operator=(_bool_column &&other) noexcept
+  {
+    bool *const data = std::exchange(other._data, nullptr);
+    std::size_t const capacity = std::exchange(other._capacity, 0);
+    _free(std::exchange(_data, data), std::exchange(_capacity, capacity));
+    _size = std::exchange(other._size, 0);
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool *data() noexcept { return _data; }
+  [[nodiscard]] constexpr bool const *data() const noexcept { return _data; }
+  [[nodiscard]] constexpr bool *begin() noexcept { return _data; }
+  [[nodiscard]] constexpr bool const *begin() const noexcept { return _data; }
+  [[nodiscard]] constexpr bool *end() noexcept { return _data + _size; }
+  [[nodiscard]] constexpr bool const *end() const noexcept { return _data + _size; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return _size; }
+  [[nodiscard]] constexpr std::size_t capacity() const noexcept { return _capacity; }
+  [[nodiscard]] constexpr bool &operator[](std::size_t i) noexcept { return _data[i]; }
+  [[nodiscard]] constexpr bool const &operator[](std::size_t i) const noexcept { return _data[i]; }
+
+  constexpr void reserve(std::size_t n)
+  {
+    if (n <= _capacity)
+      return;
+    bool *const data = std::allocator<bool>{}.allocate(n);
+    _copy(_data, _size, data);
+    _free(std::exchange(_data, data), std::exchange(_capacity, n));
+  }
+
+  constexpr bool &emplace_back(auto &&...args)
+  {
+    bool const v(FWD(args)...); // NOTE Before reallocation, since `args` might refer to an element
+    if (_size == _capacity)
+      reserve(_capacity == 0 ? 1 : 2 * _capacity);
+    return *std::construct_at(_data + _size++, v);
+  }
+
+  constexpr void pop_back() noexcept { --_size; }
+  constexpr void clear() noexcept { _size = 0; }
+
+  static constexpr void _copy(bool const *from, std::size_t size, bool *to) noexcept
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      std::construct_at(to + i, from[i]);
+  }
+
+  static constexpr void _free(bool *data, std::size_t capacity) noexcept
+  {
+    if (data != nullptr)
+      std::allocator<bool>{}.deallocate(data, capacity);
+  }
+
+  bool *_data = nullptr;
+  std::size_t _size = 0;
+  std::size_t _capacity = 0;
+};
+
+template <typename T>
+using _sum_vector_column_t = std::conditional_t<std::same_as<T, bool>, _bool_column, std::vector<T>>;
+} // namespace detail
+
+template <typename... Ts> struct sum_vector;
+template <> struct sum_vector<>; // Intentionally incomplete
+
+// NOTE Sequence of sums stored as a struct of arrays. Discriminators are kept in their own dense array and each
+// alternative in its own column, so iterating over all elements of a given type only touches that column. The
+// position of each element within its column is kept in a separate array, for indexed access.
+template <typename... Ts>
+  requires(sizeof...(Ts) > 0)
+struct sum_vector<Ts...> {
+  static_assert((... && detail::_is_valid_sum_subtype<Ts>));
+  static_assert(std::same_as<typename detail::normalized<Ts...>::template apply<::fn::sum_vector>, sum_vector>);
+
+  using value_type = sum<Ts...>;
+  using index_t = typename value_type::index_t;
+  using size_type = std::size_t;
+  using data_t = std::tuple<detail::_sum_vector_column_t<Ts>...>;
+
+  std::vector<index_t> index;
+  std::vector<size_type> offset;
+  data_t data;
+
+  template <std::size_t I> using select_nth = detail::select_nth_t<I, Ts...>;
+  template <typename T> static constexpr bool has_type = value_type::template has_type<T>;
+
+  constexpr sum_vector() = default;
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return index.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return index.empty(); }
+
+  // NOTE Reserves the discriminators and positions only, since the columns used by the elements are not known
+  constexpr void reserve(size_type n)
+  {
+    index.reserve(n);
+    offset.reserve(n);
+  }
+
+  template <typename T>
+    requires has_type<T>
+  constexpr void reserve(size_type n, std::in_place_type_t<T> = std::in_place_type<T>)
+  {
+    std::get<detail::type_index<T, Ts...>>(data).reserve(n);
+  }
+
+  constexpr void clear() noexcept
+  {
+    index.clear();
+    offset.clear();
+    std::apply([](auto &...column) { (column.clear(), ...); }, data);
+  }
+
+  template <typename T>
+  constexpr T &emplace_back(auto &&...args)
+    requires has_type<T> && (std::is_constructible_v<T, decltype(args)...>)
+  {
+    // NOTE Grow the discriminators and positions first, so if either throws, the element is not left in its column
+    _grow(index);
+    _grow(offset);
+    auto &column = std::get<detail::type_index<T, Ts...>>(data);
+    T &result = column.emplace_back(FWD(args)...);
+    offset.push_back(column.size() - 1); // NOTE Cannot throw, within the capacity
+    index.push_back(detail::type_index<T, Ts...>);
+    return result;
+  }
+
+  constexpr void push_back(value_type const &v)
+    requires(... && std::is_copy_constructible_v<Ts>)
+  {
+    detail::invoke_variadic_union<void, typename value_type::data_t>( //
+        v.data, v.index,
+        [this]<typename T>(std::in_place_type_t<T>, auto const &v) { this->template emplace_back<T>(v); });
+  }
+
+  constexpr void push_back(value_type &&v)
+    requires(... && std::is_move_constructible_v<Ts>)
+  {
+    detail::invoke_variadic_union<void, typename value_type::data_t>( //
+        std::move(v).data, v.index,
+        [this]<typename T>(std::in_place_type_t<T>, auto &&v) { this->template emplace_back<T>(std::move(v)); });
+  }
+
+  constexpr void pop_back() noexcept
+  {
+    _invoke_at<void, true>(*this, size() - 1, [this]<typename T>(std::in_place_type_t<T>, auto &) {
+      std::get<detail::type_index<T, Ts...>>(data).pop_back();
+    });
+    offset.pop_back();
+    index.pop_back();
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr std::span<T> get_span(std::in_place_type_t<T> = std::in_place_type<T>) noexcept
+  {
+    return std::get<detail::type_index<T, Ts...>>(data);
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr std::span<T const> get_span(std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return std::get<detail::type_index<T, Ts...>>(data);
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr bool has_value(size_type i, std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return index[i] == detail::type_index<T, Ts...>;
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr T *get_ptr(size_type i, std::in_place_type_t<T> = std::in_place_type<T>) noexcept
+  {
+    return has_value(i, std::in_place_type<T>) ? &std::get<detail::type_index<T, Ts...>>(data)[offset[i]] : nullptr;
+  }
+
+  template <typename T>
+    requires has_type<T>
+  [[nodiscard]] constexpr T const *get_ptr(size_type i, std::in_place_type_t<T> = std::in_place_type<T>) const noexcept
+  {
+    return has_value(i, std::in_place_type<T>) ? &std::get<detail::type_index<T, Ts...>>(data)[offset[i]] : nullptr;
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(size_type i, Fn &&fn) & noexcept(
+      detail::_is_nothrow_sum_vector_invoke<detail::_typelist_collapsing_sum, Fn, sum_vector &>)
+    requires typelist_invocable<Fn, sum_vector &> && (not typelist_type_invocable<Fn, sum_vector &>)
+  {
+    using type = detail::_typelist_collapsing_sum<decltype(fn), sum_vector &, value_type>::type;
+    return _invoke_at<type, false>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(size_type i, Fn &&fn) & noexcept(
+      detail::_is_nothrow_sum_vector_invoke_type<detail::_typelist_type_collapsing_sum, Fn, sum_vector &>)
+    requires typelist_type_invocable<Fn, sum_vector &>
+  {
+    using type = detail::_typelist_type_collapsing_sum<decltype(fn), sum_vector &, value_type>::type;
+    return _invoke_at<type, true>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(size_type i, Fn &&fn) const & noexcept(
+      detail::_is_nothrow_sum_vector_invoke<detail::_typelist_collapsing_sum, Fn, sum_vector const &>)
+    requires typelist_invocable<Fn, sum_vector const &> && (not typelist_type_invocable<Fn, sum_vector const &>)
+  {
+    using type = detail::_typelist_collapsing_sum<decltype(fn), sum_vector const &, value_type>::type;
+    return _invoke_at<type, false>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto transform(size_type i, Fn &&fn) const & noexcept(
+      detail::_is_nothrow_sum_vector_invoke_type<detail::_typelist_type_collapsing_sum, Fn, sum_vector const &>)
+    requires typelist_type_invocable<Fn, sum_vector const &>
+  {
+    using type = detail::_typelist_type_collapsing_sum<decltype(fn), sum_vector const &, value_type>::type;
+    return _invoke_at<type, true>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(size_type i, Fn &&fn) & noexcept(
+      detail::_is_nothrow_sum_vector_invoke<detail::_typelist_select_invoke_result, Fn, sum_vector &>)
+    requires typelist_invocable<Fn, sum_vector &> && (not typelist_type_invocable<Fn, sum_vector &>)
+  {
+    using type = detail::_typelist_select_invoke_result<decltype(fn), sum_vector &, value_type>::type;
+    return _invoke_at<type, false>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(size_type i, Fn &&fn) & noexcept(
+      detail::_is_nothrow_sum_vector_invoke_type<detail::_typelist_type_select_invoke_result, Fn, sum_vector &>)
+    requires typelist_type_invocable<Fn, sum_vector &>
+  {
+    using type = detail::_typelist_type_select_invoke_result<decltype(fn), sum_vector &, value_type>::type;
+    return _invoke_at<type, true>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(size_type i, Fn &&fn) const & noexcept(
+      detail::_is_nothrow_sum_vector_invoke<detail::_typelist_select_invoke_result, Fn, sum_vector const &>)
+    requires typelist_invocable<Fn, sum_vector const &> && (not typelist_type_invocable<Fn, sum_vector const &>)
+  {
+    using type = detail::_typelist_select_invoke_result<decltype(fn), sum_vector const &, value_type>::type;
+    return _invoke_at<type, false>(*this, i, FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] constexpr auto invoke(size_type i, Fn &&fn) const & noexcept(
+      detail::_is_nothrow_sum_vector_invoke_type<detail::_typelist_type_select_invoke_result, Fn, sum_vector const &>)
+    requires typelist_type_invocable<Fn, sum_vector const &>
+  {
+    using type = detail::_typelist_type_select_invoke_result<decltype(fn), sum_vector const &, value_type>::type;
+    return _invoke_at<type, true>(*this, i, FWD(fn));
+  }
+
+  static constexpr void _grow(auto &v)
+  {
+    if (v.size() == v.capacity())
+      v.reserve(v.empty() ? 1 : 2 * v.size());
+  }
+
+  template <std::size_t I, typename R, bool Typed, typename Self, typename Fn>
+  static constexpr auto _invoke_nth(Self &self, size_type i, Fn &&fn) -> R
+  {
+    if constexpr (Typed)
+      return static_cast<R>(
+          detail::_invoke(FWD(fn), std::in_place_type<select_nth<I>>, std::get<I>(self.data)[self.offset[i]]));
+    else
+      return static_cast<R>(detail::_invoke(FWD(fn), std::get<I>(self.data)[self.offset[i]]));
+  }
+
+  template <std::size_t I, typename R, bool Typed, typename Self, typename Fn>
+  static constexpr auto _invoke_chain(Self &self, size_type i, Fn &&fn) -> R
+  {
+    if constexpr (I + 1 == sizeof...(Ts)) {
+      return _invoke_nth<I, R, Typed>(self, i, FWD(fn));
+    } else {
+      if (self.index[i] == I)
+        return _invoke_nth<I, R, Typed>(self, i, FWD(fn));
+      return _invoke_chain<I + 1, R, Typed>(self, i, FWD(fn));
+    }
+  }
+
+  // NOTE Same as invoke_variadic_union, small number of alternatives is dispatched with a chain of comparisons and
+  // larger with a table of function pointers
+  template <typename R, bool Typed, typename Self, typename Fn>
+  static constexpr auto _invoke_at(Self &self, size_type i, Fn &&fn) -> R
+  {
+    if constexpr (sizeof...(Ts) > detail::_invoke_table_threshold) {
+      return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> R {
+        constexpr std::array<R (*)(Self &, size_type, Fn &&), sizeof...(Ts)> table{
+            &_invoke_nth<Is, R, Typed, Self, Fn>...};
+        return table[self.index[i]](self, i, FWD(fn));
+      }(std::index_sequence_for<Ts...>{});
+    } else {
+      return _invoke_chain<0, R, Typed>(self, i, FWD(fn));
+    }
+  }
+};
+
+template <typename... Ts> using sum_vector_for = detail::normalized<Ts...>::template apply<sum_vector>;
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_SUM_VECTOR
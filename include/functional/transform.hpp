@@ -47,6 +47,7 @@ static constexpr struct transform_t final {
   }
 
   struct apply;
+  struct fuse;
 } transform = {};
 
 struct transform_t::apply final {
@@ -58,6 +59,19 @@ struct transform_t::apply final {
   }
 };
 
+// NOTE Stage of a fused `pipeline`
+struct transform_t::fuse final {
+  [[nodiscard]] static constexpr auto operator()(auto &&next, auto &&v, auto &&fn) noexcept -> decltype(auto)
+  {
+    if constexpr (std::is_void_v<decltype(next.call(FWD(fn), FWD(v)))>) {
+      next.call(FWD(fn), FWD(v));
+      return next();
+    } else {
+      return next(next.call(FWD(fn), FWD(v)));
+    }
+  }
+};
+
 } // namespace fn
 
 #endif // INCLUDE_FUNCTIONAL_TRANSFORM
@@ -0,0 +1,145 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FUNCTIONAL_VIEWS
+#define INCLUDE_FUNCTIONAL_VIEWS
+
+#include "functional/and_then.hpp"
+#include "functional/concepts.hpp"
+#include "functional/detail/fwd_macro.hpp"
+#include "functional/filter.hpp"
+#include "functional/functor.hpp"
+#include "functional/inspect.hpp"
+#include "functional/recover.hpp"
+#include "functional/transform.hpp"
+
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace fn {
+namespace detail {
+template <typename T> constexpr bool _is_pipeline = false;
+template <typename... Fs> constexpr bool _is_pipeline<::fn::pipeline<Fs...>> = true;
+template <typename T>
+concept _some_pipeline = _is_pipeline<std::remove_cvref_t<T>>;
+
+// NOTE `std::views::transform` materializes a prvalue element only for the duration of the call, so a reference
+// returned e.g. by `inspect` would dangle; it is only kept if the element is an lvalue, i.e. refers into the range
+template <typename V, typename R>
+using _each_result_t = std::conditional_t<std::is_lvalue_reference_v<V>, R, std::remove_cvref_t<R>>;
+
+// NOTE Applies a functor (or pipeline) to each element of a range, as the function of `std::views::transform`
+template <typename F> struct _each final {
+  [[no_unique_address]] F fn;
+
+  [[nodiscard]] constexpr auto operator()(some_monadic_type auto &&v) const
+      -> _each_result_t<decltype(v), decltype(FWD(v) | fn)>
+  {
+    return FWD(v) | fn;
+  }
+};
+
+// NOTE The functions are copied, so the view does not refer to the arguments of the adaptor
+template <typename Functor> struct _each_adaptor final {
+  template <typename... Fn> using functor_t = ::fn::functor<Functor, std::decay_t<Fn>...>;
+
+  [[nodiscard]] constexpr auto operator()(auto &&...fn) const
+    requires requires { Functor{}(FWD(fn)...); }
+  {
+    return std::views::transform(_each<functor_t<decltype(fn)...>>{{{FWD(fn)...}}});
+  }
+};
+
+// NOTE A view of zero or one element, owning the element; used to split a range of prvalue `expected` without
+// evaluating each element twice, i.e. once to check and again to access it
+template <typename T> struct _maybe_view final : std::ranges::view_interface<_maybe_view<T>> {
+  std::optional<T> value;
+
+  [[nodiscard]] constexpr auto begin() noexcept -> T * { return value.has_value() ? std::addressof(*value) : nullptr; }
+  [[nodiscard]] constexpr auto end() noexcept -> T * { return begin() + value.has_value(); }
+};
+
+struct _values_part final {
+  template <typename V>
+  static constexpr bool accepts = (some_expected<V> || some_optional<V>)
+                                  && (not std::is_void_v<typename std::remove_cvref_t<V>::value_type>);
+
+  [[nodiscard]] static constexpr bool has(auto const &v) noexcept { return v.has_value(); }
+  [[nodiscard]] static constexpr auto get(auto &&v) noexcept -> decltype(auto) { return *FWD(v); }
+};
+
+struct _errors_part final {
+  template <typename V> static constexpr bool accepts = some_expected<V>;
+
+  [[nodiscard]] static constexpr bool has(auto const &v) noexcept { return not v.has_value(); }
+  [[nodiscard]] static constexpr auto get(auto &&v) noexcept -> decltype(auto) { return FWD(v).error(); }
+};
+
+// NOTE Elements of a range of `expected` (or `optional`) holding the requested part, without intermediate containers.
+// For lvalue elements, the result refers to the values (or errors) stored in the range; note that each such element
+// is accessed twice, i.e. by `std::views::filter` and then by `std::views::transform`. Otherwise each element is
+// evaluated once and the part is moved into a view of zero or one element, joined with the others.
+template <typename Part> struct _split_adaptor final {
+  template <std::ranges::viewable_range R>
+    requires Part::template accepts<std::ranges::range_reference_t<R>>
+  [[nodiscard]] constexpr auto operator()(R &&r) const
+  {
+    if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<R>>) {
+      return FWD(r) | std::views::filter([](auto const &v) noexcept { return Part::has(v); })
+             | std::views::transform([](auto &v) noexcept -> decltype(auto) { return Part::get(v); });
+    } else {
+      return FWD(r) | std::views::transform([](auto &&v) {
+               using type = std::remove_cvref_t<decltype(Part::get(FWD(v)))>;
+               if (Part::has(v))
+                 return _maybe_view<type>{{}, std::optional<type>(std::in_place, Part::get(FWD(v)))};
+               return _maybe_view<type>{};
+             })
+             | std::views::join;
+    }
+  }
+
+  template <std::ranges::viewable_range R>
+    requires Part::template accepts<std::ranges::range_reference_t<R>>
+  [[nodiscard]] constexpr friend auto operator|(R &&r, _split_adaptor const &self)
+  {
+    return self(FWD(r));
+  }
+};
+} // namespace detail
+
+// NOTE Lazy range adaptors applying monadic operations to each element of a range of `expected`, `optional` or
+// `choice`, e.g. `v | fn::views::and_then(f) | std::views::take(n)`. These are `std::views::transform` with the
+// same operations as `fn::and_then` etc. applied to a single value, and compose with standard views in the same way.
+// A chain of functors can also be applied as a single fused pipeline, e.g. `fn::views::apply(fn::and_then(f) |
+// fn::transform(g))`. Unlike the other adaptors, `apply` takes the functor as is, i.e. the functions passed to it
+// as lvalues must outlive the view.
+namespace views {
+constexpr inline struct apply_t final {
+  [[nodiscard]] constexpr auto operator()(auto &&fn) const
+    requires detail::_some_functor<decltype(fn)> || detail::_some_pipeline<decltype(fn)>
+  {
+    return std::views::transform(detail::_each<std::remove_cvref_t<decltype(fn)>>{FWD(fn)});
+  }
+} apply = {};
+
+constexpr inline detail::_each_adaptor<::fn::and_then_t> and_then = {};
+constexpr inline detail::_each_adaptor<::fn::filter_t> filter = {};
+constexpr inline detail::_each_adaptor<::fn::inspect_t> inspect = {};
+constexpr inline detail::_each_adaptor<::fn::recover_t> recover = {};
+constexpr inline detail::_each_adaptor<::fn::transform_t> transform = {};
+
+// NOTE Values (or errors) of the elements which hold one, e.g. `v | fn::views::values | std::views::take(n)`. To be
+// applied to a range directly, since range adaptor closures cannot be composed with each other before C++23
+// `std::ranges::range_adaptor_closure`.
+constexpr inline detail::_split_adaptor<detail::_values_part> values = {};
+constexpr inline detail::_split_adaptor<detail::_errors_part> errors = {};
+} // namespace views
+
+} // namespace fn
+
+#endif // INCLUDE_FUNCTIONAL_VIEWS
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/binary.hpp"
+#include "functional/choice.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Trade final {
+  std::uint64_t id;
+  double price;
+  std::uint32_t quantity;
+};
+struct Cancel final {
+  std::uint64_t id;
+};
+struct Quote final {
+  double bid;
+  double ask;
+};
+
+using type = fn::choice_for<Cancel, Quote, Trade>;
+
+constexpr std::size_t count = 1 << 20;
+
+auto make_data() -> std::vector<type>
+{
+  std::vector<type> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    switch (state % 3) {
+    case 0: result.emplace_back(Trade{i, static_cast<double>(i % 1024), static_cast<std::uint32_t>(i % 7)}); break;
+    case 1: result.emplace_back(Cancel{i}); break;
+    default: result.emplace_back(Quote{static_cast<double>(i % 1024), static_cast<double>(i % 1024) + 0.5});
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("binary_view", "[binary][binary_view][benchmark]")
+{
+  auto const bytes = fn::binary_encode(make_data());
+  fn::binary_view<type> const view{bytes};
+  REQUIRE(view.valid());
+
+  constexpr auto fn = fn::overload{[](Trade const &t) { return t.price * t.quantity; },
+                                   [](Cancel const &c) { return static_cast<double>(c.id & 1); },
+                                   [](Quote const &q) { return q.ask - q.bid; }};
+
+  auto const decoded = [&view, fn] {
+    std::vector<type> data;
+    data.reserve(view.size());
+    for (std::size_t i = 0; i < view.size(); ++i)
+      data.push_back(view[i]);
+    double result = 0;
+    for (auto const &v : data)
+      result += v.invoke(fn);
+    return result;
+  };
+  auto const in_place = [&view, fn] {
+    double result = 0;
+    for (std::size_t i = 0; i < view.size(); ++i)
+      result += view.invoke(i, fn);
+    return result;
+  };
+  REQUIRE(decoded() == in_place());
+
+  BENCHMARK("decode into std::vector") { return decoded(); };
+  BENCHMARK("visit binary_view") { return in_place(); };
+}
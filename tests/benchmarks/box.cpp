@@ -0,0 +1,135 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/box.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// NOTE Full binary tree with `1 << depth` leaves, as a recursive sum
+constexpr int depth = 20;
+
+struct Branch;
+using Tree = fn::sum_for<int, fn::box<Branch>>;
+struct Branch final {
+  Tree left;
+  Tree right;
+};
+
+// NOTE Same tree, with recursion via `std::unique_ptr`, for comparison
+struct UniqueBranch;
+using UniqueTree = fn::sum_for<int, std::unique_ptr<UniqueBranch>>;
+struct UniqueBranch final {
+  UniqueTree left;
+  UniqueTree right;
+};
+
+auto make_tree(std::pmr::memory_resource *resource, int d, int &leaf) -> Tree
+{
+  if (d == 0)
+    return Tree{leaf++};
+  Tree left = make_tree(resource, d - 1, leaf);
+  return Tree{fn::box<Branch>{std::allocator_arg, resource, std::move(left), make_tree(resource, d - 1, leaf)}};
+}
+
+auto make_unique_tree(int d, int &leaf) -> UniqueTree
+{
+  if (d == 0)
+    return UniqueTree{leaf++};
+  UniqueTree left = make_unique_tree(d - 1, leaf);
+  return UniqueTree{std::make_unique<UniqueBranch>(std::move(left), make_unique_tree(d - 1, leaf))};
+}
+
+auto total(Tree const &t) -> long
+{
+  return t.invoke(fn::overload{[](int i) -> long { return i; },
+                               [](Branch const &b) -> long { return total(b.left) + total(b.right); }});
+}
+
+auto total(UniqueTree const &t) -> long
+{
+  return t.invoke(fn::overload{[](int i) -> long { return i; }, [](std::unique_ptr<UniqueBranch> const &b) -> long {
+                                 return total(b->left) + total(b->right);
+                               }});
+}
+
+auto build(std::pmr::memory_resource *resource) -> Tree
+{
+  int leaf = 0;
+  return make_tree(resource, depth, leaf);
+}
+
+auto build_unique() -> UniqueTree
+{
+  int leaf = 0;
+  return make_unique_tree(depth, leaf);
+}
+
+} // anonymous namespace
+
+TEST_CASE("box tree", "[box][benchmark]")
+{
+  constexpr long expected = (1l << depth) * ((1l << depth) - 1) / 2;
+  {
+    std::pmr::monotonic_buffer_resource arena;
+    REQUIRE(total(build(&arena)) == expected);
+  }
+  REQUIRE(total(build(std::pmr::new_delete_resource())) == expected);
+  REQUIRE(total(build_unique()) == expected);
+
+  BENCHMARK_ADVANCED("build, box in arena")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<std::pmr::monotonic_buffer_resource>> arenas(meter.runs());
+    for (auto &a : arenas)
+      a.emplace();
+    meter.measure([&arenas](int i) { return total(build(&*arenas[i])); });
+  };
+  BENCHMARK("build, box with new/delete") { return total(build(std::pmr::new_delete_resource())); };
+  BENCHMARK("build, std::unique_ptr") { return total(build_unique()); };
+
+  {
+    std::pmr::monotonic_buffer_resource arena;
+    Tree const tree = build(&arena);
+    UniqueTree const unique = build_unique();
+    BENCHMARK("traverse, box in arena") { return total(tree); };
+    BENCHMARK("traverse, std::unique_ptr") { return total(unique); };
+  }
+
+  BENCHMARK_ADVANCED("teardown, box in arena")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<std::pmr::monotonic_buffer_resource>> arenas(meter.runs());
+    std::vector<std::optional<Tree>> trees(meter.runs());
+    for (int i = 0; i < meter.runs(); ++i)
+      trees[i].emplace(build(&arenas[i].emplace()));
+    meter.measure([&](int i) {
+      trees[i].reset();
+      arenas[i].reset();
+    });
+  };
+  BENCHMARK_ADVANCED("teardown, box with new/delete")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<Tree>> trees(meter.runs());
+    for (auto &t : trees)
+      t.emplace(build(std::pmr::new_delete_resource()));
+    meter.measure([&trees](int i) { trees[i].reset(); });
+  };
+  BENCHMARK_ADVANCED("teardown, std::unique_ptr")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::optional<UniqueTree>> trees(meter.runs());
+    for (auto &t : trees)
+      t.emplace(build_unique());
+    meter.measure([&trees](int i) { trees[i].reset(); });
+  };
+}
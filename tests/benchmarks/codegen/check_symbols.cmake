@@ -0,0 +1,18 @@
+# Fails if any of the OBJECTS refers to a symbol matching the FORBIDDEN regex, as listed by NM
+# e.g. `cmake -DNM=nm -DOBJECTS=a.o -DFORBIDDEN=bad_optional_access -P check_symbols.cmake`
+
+foreach(OBJECT ${OBJECTS})
+  execute_process(
+    COMMAND ${NM} ${OBJECT}
+    OUTPUT_VARIABLE SYMBOLS
+    RESULT_VARIABLE RESULT
+  )
+  if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "${NM} failed for ${OBJECT}")
+  endif()
+  string(REGEX MATCHALL "[^\n]*(${FORBIDDEN})[^\n]*" FOUND "${SYMBOLS}")
+  if(FOUND)
+    list(JOIN FOUND "\n" FOUND)
+    message(FATAL_ERROR "${OBJECT} refers to:\n${FOUND}")
+  endif()
+endforeach()
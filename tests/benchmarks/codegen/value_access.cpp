@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/expected.hpp"
+#include "functional/fail.hpp"
+#include "functional/filter.hpp"
+#include "functional/inspect.hpp"
+#include "functional/inspect_error.hpp"
+#include "functional/optional.hpp"
+#include "functional/or_else.hpp"
+#include "functional/recover.hpp"
+#include "functional/transform.hpp"
+#include "functional/transform_error.hpp"
+
+// NOTE Single steps of a pipeline, compiled to an object file which must not refer to `bad_expected_access` or
+// `bad_optional_access`. Once the state is known the value is accessed without a check, so there is no throw path.
+
+namespace codegen {
+
+struct Error final {
+  int code;
+};
+
+using expected_t = fn::expected<int, Error>;
+using optional_t = fn::optional<int>;
+
+constexpr auto inc = [](int i) noexcept { return i + 1; };
+constexpr auto positive = [](int i) noexcept { return i > 0; };
+constexpr auto code = [](int i) noexcept { return Error{i}; };
+constexpr auto ignore = [](auto const &...) noexcept {};
+
+auto expected_and_then(expected_t v) -> expected_t
+{
+  return v | fn::and_then([](int i) noexcept -> expected_t { return i + 1; });
+}
+
+auto expected_transform(expected_t v) -> expected_t { return v | fn::transform(inc); }
+
+auto expected_or_else(expected_t v) -> expected_t
+{
+  return v | fn::or_else([](Error e) noexcept -> expected_t { return e.code; });
+}
+
+auto expected_transform_error(expected_t v) -> fn::expected<int, int>
+{
+  return v | fn::transform_error([](Error e) noexcept { return e.code; });
+}
+
+auto expected_filter(expected_t v) -> expected_t { return v | fn::filter(positive, code); }
+auto expected_fail(expected_t v) -> expected_t
+{
+  return v | fn::fail([](int i) noexcept { return Error{i}; });
+}
+auto expected_recover(expected_t v) -> expected_t
+{
+  return v | fn::recover([](Error e) noexcept { return e.code; });
+}
+auto expected_inspect(expected_t v) -> expected_t { return v | fn::inspect(ignore); }
+auto expected_inspect_error(expected_t v) -> expected_t { return v | fn::inspect_error(ignore); }
+
+auto expected_and(expected_t a, expected_t b) -> expected_t
+{
+  return (a & b) | fn::transform([](int i, int j) noexcept { return i + j; });
+}
+
+auto expected_pipeline(expected_t v) -> expected_t { return v | (fn::transform(inc) | fn::filter(positive, code)); }
+
+auto optional_and_then(optional_t v) -> optional_t
+{
+  return v | fn::and_then([](int i) noexcept -> optional_t { return i + 1; });
+}
+
+auto optional_transform(optional_t v) -> optional_t { return v | fn::transform(inc); }
+auto optional_or_else(optional_t v) -> optional_t
+{
+  return v | fn::or_else([]() noexcept -> optional_t { return 0; });
+}
+auto optional_filter(optional_t v) -> optional_t { return v | fn::filter(positive); }
+auto optional_inspect(optional_t v) -> optional_t { return v | fn::inspect(ignore); }
+
+auto optional_and(optional_t a, optional_t b) -> optional_t
+{
+  return (a & b) | fn::transform([](int i, int j) noexcept { return i + j; });
+}
+
+} // namespace codegen
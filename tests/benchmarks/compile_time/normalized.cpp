@@ -0,0 +1,41 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/detail/meta.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifndef ALTERNATIVES
+#error "ALTERNATIVES must be defined"
+#endif
+
+namespace {
+
+// NOTE All names share a long common prefix, i.e. "(anonymous namespace in ...)::alt<"
+template <std::size_t I> struct alt final {};
+
+template <typename Is> struct alternatives;
+template <std::size_t... Is> struct alternatives<std::index_sequence<Is...>> final {
+  static constexpr std::size_t size = sizeof...(Is);
+  template <typename... Ts> using normalized = fn::detail::normalized<Ts...>::template apply<fn::detail::_ts>;
+
+  // NOTE Normalize all alternatives in reverse and in shuffled order, and normalize the result again (as would the
+  // static_assert in `sum`), then also many short lists of types, as typical for a translation unit using `sum`
+  using reversed = normalized<alt<size - 1 - Is>...>;
+  using shuffled = fn::detail::normalized<alt<(Is * 37) % size>...>::template apply<normalized>;
+  using triples = fn::detail::_ts<normalized<alt<Is>, alt<(Is * 7 + 1) % size>, alt<(Is * 13 + 2) % size>>...>;
+
+  static_assert(std::is_same_v<reversed, shuffled>);
+};
+
+} // anonymous namespace
+
+auto compile_time_normalized() -> std::size_t
+{
+  using type = alternatives<std::make_index_sequence<ALTERNATIVES>>;
+  return sizeof(type::reversed) + sizeof(type::triples);
+}
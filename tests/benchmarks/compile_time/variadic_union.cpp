@@ -0,0 +1,45 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/detail/variadic_union.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifndef ALTERNATIVES
+#error "ALTERNATIVES must be defined"
+#endif
+
+namespace {
+
+template <std::size_t I> struct alt final {
+  std::uint32_t v;
+};
+
+template <typename Is> struct alternatives;
+template <std::size_t... Is> struct alternatives<std::index_sequence<Is...>> final {
+  using type = fn::detail::variadic_union<alt<Is>...>;
+
+  // NOTE Construct, access and dispatch every alternative, as e.g. the copy constructor of `sum` would
+  static auto accumulate(std::uint32_t v) -> std::uint64_t
+  {
+    using fn::detail::_invoke_chain_tag;
+    using fn::detail::_invoke_table_tag;
+    constexpr auto fn = [](auto const &a) -> std::uint64_t { return a.v; };
+    std::uint64_t result = 0;
+    (..., (result += fn::detail::ptr_variadic_union<alt<Is>, type>(fn::detail::make_variadic_union<alt<Is>, type>(v))->v
+                     + fn::detail::invoke_variadic_union<std::uint64_t, type, _invoke_table_tag>(
+                         fn::detail::make_variadic_union<alt<Is>, type>(v), Is, fn)));
+    return result;
+  }
+};
+
+} // anonymous namespace
+
+auto compile_time_variadic_union(std::uint32_t v) -> std::uint64_t
+{
+  return alternatives<std::make_index_sequence<ALTERNATIVES>>::accumulate(v);
+}
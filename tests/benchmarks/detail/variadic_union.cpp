@@ -0,0 +1,95 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/detail/variadic_union.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+template <std::size_t I> struct alt final {
+  std::uint32_t v;
+};
+
+template <typename Is> struct alternatives;
+template <std::size_t... Is> struct alternatives<std::index_sequence<Is...>> final {
+  using type = fn::detail::variadic_union<alt<Is>...>;
+
+  struct item final {
+    type data;
+    std::size_t index;
+  };
+
+  static auto make(std::size_t index, std::uint32_t v) -> item
+  {
+    item result{fn::detail::make_variadic_union<alt<0>, type>(v), 0};
+    (void)((index == Is ? (result = item{fn::detail::make_variadic_union<alt<Is>, type>(v), Is}, true) : false)
+           || ...);
+    return result;
+  }
+};
+
+constexpr std::size_t count = 1 << 16;
+
+// NOTE Random, uniformly distributed alternatives to defeat branch prediction
+template <std::size_t N> auto make_items()
+{
+  using type = alternatives<std::make_index_sequence<N>>;
+  std::vector<typename type::item> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    result.push_back(type::make(state % N, static_cast<std::uint32_t>(i)));
+  }
+  return result;
+}
+
+template <typename Tag, std::size_t N> auto accumulate(auto const &items) -> std::uint64_t
+{
+  using type = alternatives<std::make_index_sequence<N>>::type;
+  std::uint64_t result = 0;
+  for (auto const &i : items)
+    result += fn::detail::invoke_variadic_union<std::uint64_t, type, Tag>(
+        i.data, i.index, []<typename T>(std::in_place_type_t<T>, auto const &a) -> std::uint64_t {
+          return a.v ^ sizeof(T);
+        });
+  return result;
+}
+
+template <std::size_t N> void benchmark()
+{
+  using fn::detail::_invoke_chain_tag;
+  using fn::detail::_invoke_table_tag;
+
+  auto const items = make_items<N>();
+  REQUIRE(accumulate<_invoke_chain_tag, N>(items) == accumulate<_invoke_table_tag, N>(items));
+
+  BENCHMARK("chain " + std::to_string(N)) { return accumulate<_invoke_chain_tag, N>(items); };
+  BENCHMARK("table " + std::to_string(N)) { return accumulate<_invoke_table_tag, N>(items); };
+}
+
+} // anonymous namespace
+
+TEST_CASE("invoke_variadic_union dispatch", "[variadic_union][invoke_variadic_union][benchmark]")
+{
+  // NOTE Branch misses can be collected with e.g. `perf stat -e branches,branch-misses` for each size separately
+  SECTION("2") { benchmark<2>(); }
+  SECTION("4") { benchmark<4>(); }
+  SECTION("8") { benchmark<8>(); }
+  SECTION("16") { benchmark<16>(); }
+  SECTION("32") { benchmark<32>(); }
+  SECTION("64") { benchmark<64>(); }
+  SECTION("128") { benchmark<128>(); }
+  SECTION("256") { benchmark<256>(); }
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/expected.hpp"
+#include "functional/filter.hpp"
+#include "functional/transform.hpp"
+#include "functional/transform_error.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// NOTE Built twice, also as `benchmarks_cold_errors` with FUNCTIONAL_COLD_ERRORS defined to 1, to compare the code
+// size and instructions per cycle of the same pipeline with error paths inline and out of line, e.g. with
+// `perf stat benchmarks "[error_paths]"` and `perf stat benchmarks_cold_errors "[error_paths]"`
+
+namespace {
+
+struct Error final {
+  std::string what;
+};
+
+constexpr std::size_t count = 1 << 18;
+
+// NOTE Mostly valid numbers, with errors of each kind about once in 4096 values
+auto make_data() -> std::vector<std::string>
+{
+  std::vector<std::string> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    switch (state % 4096) {
+    case 0:
+      result.emplace_back("x" + std::to_string(state % 1000));
+      break;
+    case 1:
+      result.emplace_back("-" + std::to_string(state % 1000));
+      break;
+    case 2:
+      result.emplace_back(std::to_string(100000 + state % 1000));
+      break;
+    default:
+      result.emplace_back(std::to_string(state % 100000));
+    }
+  }
+  return result;
+}
+
+auto parse(std::string const &str) noexcept -> fn::expected<int, Error>
+{
+  int result = {};
+  char const *const end = str.data() + str.size();
+  if (std::from_chars(str.data(), end, result).ptr == end)
+    return {result};
+  return std::unexpected<Error>{"Failed to parse " + str};
+}
+
+auto validate(std::string const &str) noexcept -> fn::expected<double, std::size_t>
+{
+  constexpr auto non_negative = [](int i) noexcept -> fn::expected<int, Error> {
+    if (i < 0)
+      return std::unexpected<Error>{"Negative " + std::to_string(i)};
+    return {i};
+  };
+  constexpr auto in_range = [](int i) noexcept { return i < 100000; };
+  constexpr auto out_of_range = [](int i) noexcept { return Error{"Out of range " + std::to_string(i)}; };
+  constexpr auto scale = [](int i) noexcept { return i * 0.5; };
+  constexpr auto size = [](Error const &e) noexcept { return e.what.size(); };
+  return parse(str) //
+         | fn::and_then(non_negative) | fn::filter(in_range, out_of_range) | fn::transform(scale)
+         | fn::transform_error(size);
+}
+
+} // anonymous namespace
+
+TEST_CASE("error paths", "[and_then][filter][transform][transform_error][error_paths][benchmark]")
+{
+  auto const data = make_data();
+  auto const run = [&data] {
+    double result = 0;
+    for (auto const &str : data) {
+      auto const r = validate(str);
+      result += r.has_value() ? r.value() : static_cast<double>(r.error());
+    }
+    return result;
+  };
+  REQUIRE(validate("1234").value() == 617.0);
+  REQUIRE(validate("-12").error() == std::string("Negative -12").size());
+  REQUIRE(validate("123456").error() == std::string("Out of range 123456").size());
+  REQUIRE(validate("x12").error() == std::string("Failed to parse x12").size());
+
+  BENCHMARK(FUNCTIONAL_COLD_ERRORS ? "parse and validate, cold error paths" : "parse and validate, inline error paths")
+  {
+    return run();
+  };
+}
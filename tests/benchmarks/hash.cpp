@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/hash.hpp"
+#include "functional/sum.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using type = fn::sum_for<double, int, std::string>;
+
+constexpr std::size_t count = 1 << 16;
+
+// NOTE Typical hand-written hasher, dispatching on the alternative and then mixing in the index
+struct visitor_hash final {
+  auto operator()(type const &v) const noexcept -> std::size_t
+  {
+    return v.invoke([&v]<typename T>(std::in_place_type_t<T>, T const &w) {
+      std::size_t const seed = v.index;
+      return seed ^ (std::hash<T>{}(w) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    });
+  }
+};
+
+auto make_data() -> std::vector<type>
+{
+  std::vector<type> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    auto const v = static_cast<int>(i);
+    switch (state % 3) {
+    case 0: result.emplace_back(static_cast<double>(v)); break;
+    case 1: result.emplace_back(v); break;
+    default: result.emplace_back(std::string(24, 'a') + std::to_string(v));
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("sum hash", "[sum][hash][benchmark]")
+{
+  auto const data = make_data();
+
+  auto const hash_all = [&data](auto hash) {
+    std::size_t result = 0;
+    for (auto const &s : data)
+      result += hash(s);
+    return result;
+  };
+  REQUIRE(hash_all(std::hash<type>{}) == hash_all(visitor_hash{}));
+
+  BENCHMARK("visitor hash") { return hash_all(visitor_hash{}); };
+  BENCHMARK("std::hash") { return hash_all(std::hash<type>{}); };
+}
+
+TEST_CASE("sum heterogeneous lookup", "[sum][hash][benchmark]")
+{
+  auto const data = make_data();
+  std::unordered_map<type, std::size_t, std::hash<type>, fn::sum_equal_to> map;
+  for (std::size_t i = 0; i < data.size(); ++i)
+    map.emplace(data[i], i);
+
+  std::vector<std::string> keys;
+  for (auto const &s : data) {
+    if (auto const *p = s.get_ptr(std::in_place_type<std::string>))
+      keys.push_back(*p);
+  }
+
+  auto const with_sum = [&map, &keys] {
+    std::size_t result = 0;
+    for (auto const &k : keys)
+      result += map.find(type{k})->second;
+    return result;
+  };
+  auto const transparent = [&map, &keys] {
+    std::size_t result = 0;
+    for (auto const &k : keys)
+      result += map.find(k)->second;
+    return result;
+  };
+  REQUIRE(with_sum() == transparent());
+
+  BENCHMARK("find with sum") { return with_sum(); };
+  BENCHMARK("find transparent") { return transparent(); };
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/invoke_batched.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using type = fn::sum_for<double, float, int, long>;
+
+constexpr std::size_t count = 1 << 20;
+
+// NOTE Alternatives are uniformly random, so element-by-element dispatch mispredicts on most elements
+auto make_data() -> std::vector<type>
+{
+  std::vector<type> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    auto const v = static_cast<int>(i % 1024);
+    switch (state % 4) {
+    case 0: result.emplace_back(static_cast<double>(v)); break;
+    case 1: result.emplace_back(static_cast<float>(v)); break;
+    case 2: result.emplace_back(v); break;
+    default: result.emplace_back(static_cast<long>(v));
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("invoke_batched", "[sum][invoke_batched][benchmark]")
+{
+  auto const data = make_data();
+  constexpr auto fn = fn::overload{[](double d) { return d * 0.5; }, [](float f) { return f * 2.0; },
+                                   [](int i) { return i + 1.0; }, [](long l) { return l - 1.0; }};
+
+  auto const per_element = [&data, fn] {
+    double result = 0;
+    for (auto const &s : data)
+      result += s.invoke(fn);
+    return result;
+  };
+  auto const batched = [&data, fn] {
+    double result = 0;
+    fn::invoke_batched(data, [&result, fn](auto v) { result += fn(v); });
+    return result;
+  };
+  REQUIRE(per_element() == batched());
+
+  BENCHMARK("per element") { return per_element(); };
+  BENCHMARK("batched") { return batched(); };
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/open_sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <any>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t count = 1 << 16;
+
+// NOTE Too large for the small-object storage of `std::any` in common implementations, but fits in `open_sum<>`
+struct Point final {
+  double x;
+  double y;
+  double z;
+};
+
+template <typename T> auto make_data() -> std::vector<T>
+{
+  std::vector<T> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const v = static_cast<double>(i);
+    if (i % 2 == 0)
+      result.emplace_back(Point{v, v, v});
+    else
+      result.emplace_back(static_cast<int>(i));
+  }
+  return result;
+}
+
+auto total(std::vector<fn::open_sum<>> const &data) -> double
+{
+  double result = 0;
+  for (auto const &v : data)
+    result += v.invoke<Point, int>(fn::overload{[](Point const &p) { return p.x + p.y + p.z; },
+                                                [](int i) { return static_cast<double>(i); },
+                                                [](fn::open_sum<> const &) { return 0.0; }});
+  return result;
+}
+
+auto total(std::vector<std::any> const &data) -> double
+{
+  double result = 0;
+  for (auto const &v : data) {
+    if (auto const *p = std::any_cast<Point>(&v))
+      result += p->x + p->y + p->z;
+    else if (auto const *i = std::any_cast<int>(&v))
+      result += static_cast<double>(*i);
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("open_sum vs std::any", "[open_sum][benchmark]")
+{
+  auto const data = make_data<fn::open_sum<>>();
+  auto const any = make_data<std::any>();
+  REQUIRE(total(data) == total(any));
+
+  BENCHMARK("build, open_sum") { return make_data<fn::open_sum<>>(); };
+  BENCHMARK("build, std::any") { return make_data<std::any>(); };
+  BENCHMARK("copy, open_sum") { return std::vector<fn::open_sum<>>(data); };
+  BENCHMARK("copy, std::any") { return std::vector<std::any>(any); };
+  BENCHMARK("access, open_sum") { return total(data); };
+  BENCHMARK("access, std::any") { return total(any); };
+}
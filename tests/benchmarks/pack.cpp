@@ -0,0 +1,64 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/pack.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+// NOTE Same elements as `pack_type`, laid out in logical order
+struct logical_type final {
+  char a;
+  double b;
+  char c;
+  double d;
+};
+
+using pack_type = fn::pack<char, double, char, double>;
+static_assert(sizeof(pack_type) < sizeof(logical_type));
+
+constexpr std::size_t count = 1 << 20;
+
+template <typename T> auto make_data(auto make)
+{
+  std::vector<T> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    result.push_back(make(static_cast<char>(i % 64), static_cast<double>(i % 1024)));
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("pack layout", "[pack][benchmark]")
+{
+  constexpr auto make_pack = [](char c, double d) { return pack_type{c, d, c, d}; };
+  constexpr auto make_logical = [](char c, double d) { return logical_type{c, d, c, d}; };
+  auto const packs = make_data<pack_type>(make_pack);
+  auto const logicals = make_data<logical_type>(make_logical);
+
+  auto const pack_sum = [&packs] {
+    double result = 0;
+    for (auto const &p : packs)
+      result += p.invoke([](char a, double b, char c, double d) { return a + b + c + d; });
+    return result;
+  };
+  auto const logical_sum = [&logicals] {
+    double result = 0;
+    for (auto const &p : logicals)
+      result += p.a + p.b + p.c + p.d;
+    return result;
+  };
+  REQUIRE(pack_sum() == logical_sum());
+
+  BENCHMARK("vector of pack, build") { return make_data<pack_type>(make_pack); };
+  BENCHMARK("vector of struct, build") { return make_data<logical_type>(make_logical); };
+  BENCHMARK("vector of pack, sum") { return pack_sum(); };
+  BENCHMARK("vector of struct, sum") { return logical_sum(); };
+}
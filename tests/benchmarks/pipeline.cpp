@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/expected.hpp"
+#include "functional/filter.hpp"
+#include "functional/functor.hpp"
+#include "functional/inspect.hpp"
+#include "functional/transform.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+enum class error { odd, negative, empty };
+using type = fn::expected<long, error>;
+
+constexpr std::size_t count = 1 << 20;
+
+// NOTE Most values pass all stages, with the rest failing at different stages
+auto make_data() -> std::vector<type>
+{
+  std::vector<type> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    if (state % 16 == 0)
+      result.emplace_back(std::unexpect, error::empty);
+    else
+      result.emplace_back(static_cast<long>(state % 4096) - 256);
+  }
+  return result;
+}
+
+constexpr auto half = [](long i) -> type {
+  if (i % 2 != 0)
+    return std::unexpected<error>(error::odd);
+  return {i / 2};
+};
+constexpr auto scale = [](long i) { return i * 3 + 1; };
+constexpr auto positive = [](long i) { return i > 0; };
+constexpr auto negative = [](long) { return error::negative; };
+
+// NOTE Same stages written by hand
+auto hand_written(type const &v) -> type
+{
+  if (not v.has_value())
+    return type{std::unexpect, v.error()};
+  long i = v.value();
+  if (i % 2 != 0)
+    return type{std::unexpect, error::odd};
+  i = scale(i / 2);
+  if (not positive(i))
+    return type{std::unexpect, negative(i)};
+  return type{scale(i)};
+}
+
+} // anonymous namespace
+
+TEST_CASE("pipeline", "[functor][pipeline][benchmark]")
+{
+  auto const data = make_data();
+  auto const fused = fn::and_then(half) | fn::transform(scale) | fn::filter(positive, negative)
+                     | fn::inspect([](long) {}) | fn::transform(scale);
+
+  auto const run = [&data](auto fn) {
+    long result = 0;
+    for (auto const &v : data) {
+      auto const r = fn(v);
+      result += r.has_value() ? r.value() : static_cast<long>(r.error());
+    }
+    return result;
+  };
+  auto const run_fused = [&] { return run([&fused](type const &v) { return v | fused; }); };
+  auto const run_sequential = [&] {
+    return run([](type const &v) {
+      return v | fn::and_then(half) | fn::transform(scale) | fn::filter(positive, negative) | fn::inspect([](long) {})
+             | fn::transform(scale);
+    });
+  };
+  auto const run_hand_written = [&] { return run(hand_written); };
+  REQUIRE(run_fused() == run_hand_written());
+  REQUIRE(run_sequential() == run_hand_written());
+
+  BENCHMARK("fused pipeline") { return run_fused(); };
+  BENCHMARK("functors one by one") { return run_sequential(); };
+  BENCHMARK("hand-written") { return run_hand_written(); };
+}
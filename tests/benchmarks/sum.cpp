@@ -0,0 +1,260 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/detail/variadic_union.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// NOTE Layout of `sum` with `std::size_t` discriminator, for comparison
+template <typename... Ts> struct wide_sum final {
+  using data_t = fn::detail::variadic_union<Ts...>;
+  data_t data;
+  std::size_t index;
+
+  template <typename T> static constexpr auto make(T v) -> wide_sum
+  {
+    return {fn::detail::make_variadic_union<T, data_t>(v), fn::detail::type_index<T, Ts...>};
+  }
+
+  constexpr auto invoke(auto &&fn) const
+  {
+    return fn::detail::invoke_variadic_union<double, data_t>(data, index, FWD(fn));
+  }
+};
+
+constexpr std::size_t count = 1 << 20;
+
+template <typename Sum> auto accumulate(std::vector<Sum> const &v) -> double
+{
+  double result = 0;
+  for (auto const &s : v)
+    result += s.invoke([](auto i) -> double { return i; });
+  return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("sum layout", "[sum][benchmark]")
+{
+  using compact_type = fn::sum<float, int>;
+  using wide_type = wide_sum<float, int>;
+  static_assert(sizeof(compact_type) == 8);
+  static_assert(sizeof(wide_type) == 16);
+
+  std::vector<compact_type> compact;
+  std::vector<wide_type> wide;
+  compact.reserve(count);
+  wide.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 3 == 0) {
+      compact.emplace_back(static_cast<float>(i % 1024));
+      wide.push_back(wide_type::make(static_cast<float>(i % 1024)));
+    } else {
+      compact.emplace_back(static_cast<int>(i % 1024));
+      wide.push_back(wide_type::make(static_cast<int>(i % 1024)));
+    }
+  }
+  REQUIRE(accumulate(compact) == accumulate(wide));
+
+  BENCHMARK("vector<sum<float, int>> with std::uint8_t index") { return accumulate(compact); };
+  BENCHMARK("vector<sum<float, int>> with std::size_t index") { return accumulate(wide); };
+}
+
+TEST_CASE("sum assignment", "[sum][benchmark]")
+{
+  // NOTE Long-lived state slots, updated mostly with the alternative they already hold
+  using type = fn::sum_for<std::string, int>;
+  constexpr std::size_t slots = 1 << 12;
+  std::vector<type> const updates = [] {
+    std::vector<type> result;
+    result.reserve(slots);
+    for (std::size_t i = 0; i < slots; ++i) {
+      if (i % 16 == 0)
+        result.emplace_back(static_cast<int>(i));
+      else
+        result.emplace_back(std::string(64, static_cast<char>('a' + i % 26)));
+    }
+    return result;
+  }();
+  std::vector<type> state(slots, type{std::string(64, ' ')});
+
+  BENCHMARK("destroy and construct")
+  {
+    for (std::size_t i = 0; i < slots; ++i) {
+      std::destroy_at(&state[i]);
+      std::construct_at(&state[i], updates[i]);
+    }
+    return state.size();
+  };
+  BENCHMARK("copy assignment")
+  {
+    for (std::size_t i = 0; i < slots; ++i)
+      state[i] = updates[i];
+    return state.size();
+  };
+  std::string const payload(64, 'x');
+  BENCHMARK("emplace")
+  {
+    for (std::size_t i = 0; i < slots; ++i)
+      state[i].emplace<std::string>(payload);
+    return state.size();
+  };
+}
+
+namespace {
+
+// NOTE Equality comparison as implemented before flattened dispatch of several sums, for comparison
+template <typename... Ts, typename... Tx>
+constexpr bool nested_equal(fn::sum<Ts...> const &lh, fn::sum<Tx...> const &rh) noexcept
+{
+  return lh.template invoke_r<bool>([&rh]<typename T>(std::in_place_type_t<T> d, auto const &lh) noexcept {
+    if constexpr (std::remove_cvref_t<decltype(rh)>::template has_type<T>) {
+      return rh.has_value(d) && lh == *rh.get_ptr(d);
+    } else {
+      return false;
+    }
+  });
+}
+
+} // anonymous namespace
+
+TEST_CASE("sum equality", "[sum][benchmark]")
+{
+  using lh_type = fn::sum_for<double, float, int, long>;
+  using rh_type = fn::sum_for<double, int, long, short>;
+  std::vector<lh_type> lh;
+  std::vector<rh_type> rh;
+  lh.reserve(count);
+  rh.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    auto const v = static_cast<int>(state % 4);
+    switch ((state >> 8) % 4) {
+    case 0: lh.emplace_back(static_cast<double>(v)); break;
+    case 1: lh.emplace_back(static_cast<float>(v)); break;
+    case 2: lh.emplace_back(v); break;
+    default: lh.emplace_back(static_cast<long>(v));
+    }
+    switch ((state >> 16) % 4) {
+    case 0: rh.emplace_back(static_cast<double>(v)); break;
+    case 1: rh.emplace_back(v); break;
+    case 2: rh.emplace_back(static_cast<long>(v)); break;
+    default: rh.emplace_back(static_cast<short>(v));
+    }
+  }
+
+  auto const count_equal = [&](auto const &fn) {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < count; ++i)
+      result += fn(lh[i], rh[i]);
+    return result;
+  };
+  auto const nested = [](auto const &l, auto const &r) { return nested_equal(l, r); };
+  REQUIRE(count_equal(std::equal_to<>{}) == count_equal(nested));
+
+  BENCHMARK("nested dispatch") { return count_equal(nested); };
+  BENCHMARK("flattened dispatch") { return count_equal(std::equal_to<>{}); };
+  BENCHMARK("flattened dispatch, table")
+  {
+    return count_equal([](auto const &l, auto const &r) {
+      using fn::detail::_invoke_table_tag;
+      return fn::detail::_invoke_sums<bool, _invoke_table_tag>(fn::detail::_equal_sums{}, l, r);
+    });
+  };
+}
+
+namespace {
+
+struct Click final {
+  int x;
+  int y;
+};
+struct Key final {
+  int code;
+};
+struct Resize final {
+  int w;
+  int h;
+};
+struct Tick final {
+  long time;
+};
+
+// NOTE Conversion from a subset as implemented before the precomputed index table, dispatching once for the value and
+// once again for the index. Only valid for trivially copyable alternatives, since it assigns `data` directly
+template <typename... Ts, typename Source> constexpr void nested_widen(fn::sum<Ts...> &t, Source const &s) noexcept
+{
+  using data_t = fn::sum<Ts...>::data_t;
+  t.data = s.template invoke_r<data_t>([]<typename T>(std::in_place_type_t<T>, auto const &v) {
+    return fn::detail::make_variadic_union<T, data_t>(v);
+  });
+  using index_t = fn::sum<Ts...>::index_t;
+  t.index = s.template invoke_r<index_t>([]<typename T>(std::in_place_type_t<T>, auto const &) { //
+    return static_cast<index_t>(fn::detail::type_index<T, Ts...>);
+  });
+}
+
+} // anonymous namespace
+
+TEST_CASE("sum widening", "[sum][benchmark]")
+{
+  // NOTE Events from a narrow source are widened to the event type of the pipeline, then handled
+  using source_type = fn::sum_for<Click, Key>;
+  using event_type = fn::sum_for<Click, Key, Resize, Tick>;
+  std::vector<source_type> source;
+  source.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    auto const v = static_cast<int>(state % 1024);
+    if (state % 2 == 0)
+      source.emplace_back(Click{v, v + 1});
+    else
+      source.emplace_back(Key{v});
+  }
+  std::vector<event_type> events(count, event_type{Tick{0}});
+
+  auto const handle = [&events] {
+    std::size_t result = 0;
+    for (auto const &e : events)
+      result += e.invoke(fn::overload{[](Click const &c) { return static_cast<std::size_t>(c.x + c.y); },
+                                      [](Key const &k) { return static_cast<std::size_t>(k.code); },
+                                      [](Resize const &) { return std::size_t{0}; },
+                                      [](Tick const &) { return std::size_t{0}; }});
+    return result;
+  };
+
+  BENCHMARK("nested dispatch")
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      nested_widen(events[i], source[i]);
+    return handle();
+  };
+  auto const nested = handle();
+  BENCHMARK("converting constructor")
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      events[i] = event_type{source[i]};
+    return handle();
+  };
+  REQUIRE(handle() == nested);
+}
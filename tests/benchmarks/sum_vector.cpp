@@ -0,0 +1,100 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/sum.hpp"
+#include "functional/sum_vector.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using payload = std::array<double, 3>;
+using sum_type = fn::sum_for<double, int, payload>;
+using vector_type = fn::sum_vector_for<double, int, payload>;
+
+constexpr std::size_t count = 1 << 20;
+
+// NOTE Percentage of int elements, with the rest split evenly between remaining alternatives
+template <unsigned Percent> auto make_data()
+{
+  std::vector<sum_type> aos;
+  vector_type soa;
+  aos.reserve(count);
+  soa.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    auto const v = static_cast<int>(i % 1024);
+    if (state % 100 < Percent)
+      aos.emplace_back(v);
+    else if (state % 2 == 0)
+      aos.emplace_back(static_cast<double>(v));
+    else
+      aos.emplace_back(payload{1.0, 2.0, 3.0});
+    soa.push_back(aos.back());
+  }
+  return std::pair{std::move(aos), std::move(soa)};
+}
+
+template <unsigned Percent> void benchmark()
+{
+  auto const [aos, soa] = make_data<Percent>();
+
+  auto const aos_ints = [&aos] {
+    std::int64_t result = 0;
+    for (auto const &s : aos)
+      if (auto const *p = s.get_ptr(std::in_place_type<int>); p != nullptr)
+        result += *p;
+    return result;
+  };
+  auto const soa_ints = [&soa] {
+    std::int64_t result = 0;
+    for (int i : soa.get_span(std::in_place_type<int>))
+      result += i;
+    return result;
+  };
+  REQUIRE(aos_ints() == soa_ints());
+
+  constexpr auto fn = fn::overload{[](int i) -> double { return i; }, [](double d) -> double { return d; },
+                                   [](payload const &p) -> double { return p[0]; }};
+  auto const aos_all = [&aos, fn] {
+    double result = 0;
+    for (auto const &s : aos)
+      result += s.invoke(fn);
+    return result;
+  };
+  auto const soa_all = [&soa, fn] {
+    double result = 0;
+    for (int i : soa.get_span(std::in_place_type<int>))
+      result += fn(i);
+    for (double d : soa.get_span(std::in_place_type<double>))
+      result += fn(d);
+    for (payload const &p : soa.get_span(std::in_place_type<payload>))
+      result += fn(p);
+    return result;
+  };
+  REQUIRE(aos_all() == soa_all());
+
+  BENCHMARK("vector of sum, all int") { return aos_ints(); };
+  BENCHMARK("sum_vector, all int") { return soa_ints(); };
+  BENCHMARK("vector of sum, all elements") { return aos_all(); };
+  BENCHMARK("sum_vector, all elements") { return soa_all(); };
+}
+
+} // anonymous namespace
+
+TEST_CASE("sum_vector", "[sum_vector][benchmark]")
+{
+  SECTION("mixed") { benchmark<34>(); }
+  SECTION("skewed") { benchmark<95>(); }
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/expected.hpp"
+#include "functional/functor.hpp"
+#include "functional/transform.hpp"
+#include "functional/views.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+enum class error { odd, empty };
+using type = fn::expected<long, error>;
+
+constexpr std::size_t count = 1 << 20;
+
+// NOTE Most values pass all stages, with the rest failing at different stages
+auto make_data() -> std::vector<type>
+{
+  std::vector<type> result;
+  result.reserve(count);
+  std::uint64_t state = 0x9e3779b97f4a7c15ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    if (state % 16 == 0)
+      result.emplace_back(std::unexpect, error::empty);
+    else
+      result.emplace_back(static_cast<long>(state % 4096) - 256);
+  }
+  return result;
+}
+
+constexpr auto half = [](long i) -> type {
+  if (i % 2 != 0)
+    return std::unexpected<error>(error::odd);
+  return {i / 2};
+};
+constexpr auto scale = [](long i) { return i * 3 + 1; };
+
+} // anonymous namespace
+
+TEST_CASE("views", "[views][and_then][transform][benchmark]")
+{
+  auto const data = make_data();
+
+  auto const sum = [](auto &&r) {
+    long result = 0;
+    for (long i : r)
+      result += i;
+    return result;
+  };
+  auto const run_views = [&] {
+    return sum(data | fn::views::and_then(half) | fn::views::transform(scale) | fn::views::values);
+  };
+  auto const run_fused = [&] {
+    return sum(data | fn::views::apply(fn::and_then(half) | fn::transform(scale)) | fn::views::values);
+  };
+  // NOTE Same stages and split written by hand
+  auto const run_hand_written = [&] {
+    long result = 0;
+    for (auto const &v : data) {
+      if (not v.has_value() || v.value() % 2 != 0)
+        continue;
+      result += scale(v.value() / 2);
+    }
+    return result;
+  };
+  REQUIRE(run_views() == run_hand_written());
+  REQUIRE(run_fused() == run_hand_written());
+
+  BENCHMARK("views one by one") { return run_views(); };
+  BENCHMARK("view of fused pipeline") { return run_fused(); };
+  BENCHMARK("hand-written") { return run_hand_written(); };
+}
+
+TEST_CASE("views values and errors", "[views][values][errors][benchmark]")
+{
+  auto const data = make_data();
+
+  auto const run_views = [&] {
+    long result = 0;
+    for (long i : data | fn::views::values)
+      result += i;
+    for (error e : data | fn::views::errors)
+      result -= static_cast<long>(e) + 1;
+    return result;
+  };
+  auto const run_hand_written = [&] {
+    long result = 0;
+    for (auto const &v : data) {
+      if (v.has_value())
+        result += v.value();
+    }
+    for (auto const &v : data) {
+      if (not v.has_value())
+        result -= static_cast<long>(v.error()) + 1;
+    }
+    return result;
+  };
+  REQUIRE(run_views() == run_hand_written());
+
+  BENCHMARK("split with views") { return run_views(); };
+  BENCHMARK("split by hand") { return run_hand_written(); };
+}
@@ -0,0 +1,203 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/binary.hpp"
+#include "functional/choice.hpp"
+#include "functional/pack.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+struct Point final {
+  int x;
+  int y;
+
+  constexpr bool operator==(Point const &) const noexcept = default;
+};
+
+template <typename T>
+concept has_binary_format = requires { fn::binary_format<T>::record_size; };
+} // anonymous namespace
+
+TEST_CASE("sum from_index", "[sum][from_index]")
+{
+  using type = fn::sum_for<double, int, Point>;
+  static_assert(std::is_same_v<type, fn::sum<Point, double, int>>);
+
+  WHEN("runtime")
+  {
+    Point const p{3, 14};
+    auto const s = type::from_index(0, std::as_bytes(std::span{&p, 1}));
+    CHECK(s == type{p});
+
+    int const i = 42;
+    CHECK(type::from_index(2, std::as_bytes(std::span{&i, 1})) == type{42});
+  }
+
+  WHEN("constexpr")
+  {
+    constexpr std::array<std::byte, 4> bytes = std::bit_cast<std::array<std::byte, 4>>(12);
+    static_assert(type::from_index(2, bytes) == type{12});
+    static_assert(fn::choice<bool, int>::from_index(1, bytes) == fn::choice<bool, int>{12});
+  }
+
+  WHEN("choice")
+  {
+    using choice = fn::choice_for<int, Point>;
+    Point const p{1, 2};
+    auto const c = choice::from_index(0, std::as_bytes(std::span{&p, 1}));
+    static_assert(std::is_same_v<decltype(c), choice const>);
+    CHECK(c == choice{p});
+  }
+}
+
+TEST_CASE("binary_format", "[binary]")
+{
+  WHEN("sum layout")
+  {
+    using format = fn::binary_format<fn::sum<double, int>>;
+    static_assert(format::alignment == 8);
+    static_assert(format::payload_offset == 8);
+    static_assert(format::record_size == 16);
+    static_assert(format::data_offset == 24);
+    static_assert(format::type_key == fn::detail::_fnv1a("fn::sum<double, int>"));
+    static_assert(fn::binary_format<fn::choice<double, int>>::type_key == format::type_key);
+
+    std::array<std::byte, format::record_size> record;
+    record.fill(std::byte{0xff});
+    format::encode(fn::sum<double, int>{12}, record.data());
+    CHECK(format::index(record.data()) == 1);
+    CHECK(format::valid(record.data()));
+    // NOTE Bytes not used by the discriminator nor by the alternative are zeroed
+    CHECK(record[1] == std::byte{0});
+    CHECK(record[12] == std::byte{0});
+    CHECK(format::decode(record.data()) == fn::sum<double, int>{12});
+    record[0] = std::byte{2};
+    CHECK(not format::valid(record.data()));
+  }
+
+  WHEN("small sum layout")
+  {
+    using format = fn::binary_format<fn::sum<bool, char>>;
+    static_assert(format::alignment == 1);
+    static_assert(format::record_size == 2);
+    static_assert(format::data_offset == sizeof(fn::binary_header));
+  }
+
+  WHEN("pack layout")
+  {
+    using format = fn::binary_format<fn::pack<char, double, int>>;
+    static_assert(format::offsets == std::array<std::size_t, 3>{0, 8, 16});
+    static_assert(format::record_size == 24);
+    static_assert(format::alignment == 8);
+
+    std::array<std::byte, format::record_size> record;
+    format::encode(fn::pack<char, double, int>{'a', 0.5, 12}, record.data());
+    CHECK(format::decode(record.data()) == fn::pack<char, double, int>{'a', 0.5, 12});
+    CHECK(format::invoke(record.data(), [](char c, double d, int i) { return c == 'a' && d == 0.5 && i == 12; }));
+  }
+
+  static_assert(has_binary_format<fn::sum<double, int>>);
+  static_assert(has_binary_format<fn::pack<double, int>>);
+  static_assert(not has_binary_format<fn::sum<int, std::vector<int>>>);
+  static_assert(not has_binary_format<fn::pack<int &>>);
+  static_assert(not has_binary_format<fn::pack<>>);
+}
+
+TEST_CASE("binary_view", "[binary][binary_view]")
+{
+  using type = fn::choice_for<double, int, Point>;
+  std::vector<type> const data{type{0.5}, type{12}, type{Point{3, 14}}, type{13}};
+  auto const bytes = fn::binary_encode(data);
+  using format = fn::binary_format<type>;
+  CHECK(bytes.size() == format::data_offset + data.size() * format::record_size);
+
+  fn::binary_view<type> const view{bytes};
+  REQUIRE(view.valid());
+  CHECK(view.size() == 4);
+  CHECK(not view.empty());
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    CHECK(view[i] == data[i]);
+    CHECK(view.index(i) == data[i].index);
+  }
+
+  WHEN("visit in place")
+  {
+    constexpr auto fn = fn::overload{[](double const &) { return 1; }, [](int const &i) { return i; },
+                                     [](Point const &p) { return p.x + p.y; }};
+    CHECK(view.invoke(0, fn) == 1);
+    CHECK(view.invoke(1, fn) == 12);
+    CHECK(view.invoke(2, fn) == 17);
+    CHECK(view.invoke(2, [&bytes](auto const &v) { return static_cast<void const *>(&v); })
+          == static_cast<void const *>(bytes.data() + format::data_offset + 2 * format::record_size
+                                       + format::payload_offset));
+    CHECK(view.invoke(3, []<typename T>(std::in_place_type_t<T>, T const &) { return std::is_same_v<T, int>; }));
+
+    static_assert(not noexcept(view.invoke(0, fn)));
+    static_assert(noexcept(view.invoke(0, [](auto const &) noexcept { return 0; })));
+    constexpr auto typed = []<typename T>(std::in_place_type_t<T>, T const &) noexcept {};
+    static_assert(noexcept(format::invoke(bytes.data(), typed)));
+    static_assert(not noexcept(format::invoke(bytes.data(), []<typename T>(std::in_place_type_t<T>, T const &) {})));
+  }
+
+  WHEN("read as sum")
+  {
+    fn::binary_view<fn::sum<Point, double, int>> const other{bytes};
+    REQUIRE(other.valid());
+    CHECK(other[2] == data[2].value());
+  }
+
+  WHEN("invalid")
+  {
+    CHECK(not fn::binary_view<fn::sum<double, int>>{bytes}.valid());
+    CHECK(not fn::binary_view<type>{std::span{bytes}.first(bytes.size() - 1)}.valid());
+    CHECK(not fn::binary_view<type>{std::span{bytes}.first(8)}.valid());
+    CHECK(not fn::binary_view<type>{std::span{bytes}.subspan(4)}.valid());
+
+    auto copy = bytes;
+    copy[format::data_offset + format::record_size] = std::byte{7};
+    CHECK(not fn::binary_view<type>{copy}.valid());
+
+    copy = bytes;
+    fn::binary_header header = format::header();
+    header.version += 1;
+    std::memcpy(copy.data(), &header, sizeof(header));
+    CHECK(not fn::binary_view<type>{copy}.valid());
+  }
+
+  WHEN("empty")
+  {
+    auto const none = fn::binary_encode(std::vector<type>{});
+    fn::binary_view<type> const view{none};
+    CHECK(view.valid());
+    CHECK(view.empty());
+  }
+
+  WHEN("pack")
+  {
+    using pack = fn::pack<int, double>;
+    std::vector<pack> const packs{pack{1, 0.5}, pack{2, 1.5}};
+    auto const bytes = fn::binary_encode(packs);
+    fn::binary_view<pack> const view{bytes};
+    REQUIRE(view.valid());
+    CHECK(view.size() == 2);
+    CHECK(view[1] == packs[1]);
+    CHECK(view.invoke(1, [](int const &i, double const &d) { return i + d; }) == 3.5);
+    static_assert(not noexcept(view.invoke(1, [](int const &i, double const &d) { return i + d; })));
+    static_assert(noexcept(view.invoke(1, [](int const &i, double const &d) noexcept { return i + d; })));
+  }
+}
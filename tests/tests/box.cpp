@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/box.hpp"
+#include "functional/choice.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct List;
+using Json = fn::choice_for<double, std::string, fn::box<List>>;
+struct List final {
+  std::vector<Json> items;
+
+  bool operator==(List const &) const = default;
+};
+
+struct Branch;
+using Tree = fn::sum_for<int, fn::box<Branch>>;
+struct Branch final {
+  Tree left;
+  Tree right;
+};
+
+auto total(Tree const &t) -> int
+{
+  return t.invoke(fn::overload{[](int i) { return i; },
+                               [](Branch const &b) { return total(b.left) + total(b.right); }});
+}
+
+struct counting_resource final : std::pmr::memory_resource {
+  std::size_t allocated = 0;
+  std::size_t deallocated = 0;
+
+  auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override
+  {
+    ++allocated;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocated;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  auto do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool override { return this == &other; }
+};
+
+} // anonymous namespace
+
+TEST_CASE("box", "[box]")
+{
+  static_assert(sizeof(fn::box<List>) == sizeof(void *));
+  static_assert(fn::some_box<fn::box<List>>);
+  static_assert(not fn::some_box<List>);
+  static_assert(Json::has_type<fn::box<List>>);
+
+  WHEN("value semantics")
+  {
+    fn::box<std::string> a{std::string("abc")};
+    fn::box<std::string> b{a};
+    CHECK(*a == "abc");
+    CHECK(*b == "abc");
+    CHECK(a.get() != b.get());
+    CHECK(a == b);
+    b->append("d");
+    CHECK(a != b);
+    CHECK(a < b);
+
+    fn::box<std::string> c{std::in_place, 3, 'x'};
+    c = b;
+    CHECK(*c == "abcd");
+    std::string const *const p = c.get();
+    a = std::move(c);
+    CHECK(a.get() == p);
+    CHECK(*std::move(a) == "abcd");
+  }
+
+  WHEN("move assignment from owned value")
+  {
+    Tree t{fn::box<Branch>{Branch{Tree{1}, Tree{fn::box<Branch>{Branch{Tree{2}, Tree{3}}}}}}};
+    auto &outer = *t.get_ptr<fn::box<Branch>>();
+    CHECK(total(t) == 6);
+    outer = std::move(*outer->right.get_ptr<fn::box<Branch>>());
+    CHECK(total(t) == 5);
+  }
+
+  WHEN("sum assignment from a value owned by a box")
+  {
+    Tree t{fn::box<Branch>{Branch{Tree{1}, Tree{fn::box<Branch>{Branch{Tree{2}, Tree{3}}}}}}};
+    t = (*t.get_ptr<fn::box<Branch>>())->left;
+    CHECK(t.has_value<int>());
+    CHECK(total(t) == 1);
+
+    Tree u{fn::box<Branch>{Branch{Tree{4}, Tree{5}}}};
+    u = std::move((*u.get_ptr<fn::box<Branch>>())->right);
+    CHECK(u.has_value<int>());
+    CHECK(total(u) == 5);
+  }
+
+  WHEN("memory resource")
+  {
+    counting_resource resource;
+    {
+      fn::box<List> a{std::allocator_arg, &resource, List{{Json{0.5}}}};
+      CHECK(a.get_allocator().resource() == &resource);
+      CHECK(resource.allocated == 1);
+      fn::box<List> const b{a};
+      CHECK(b.get_allocator().resource() == &resource);
+      CHECK(resource.allocated == 2);
+      fn::box<List> const c{std::move(a)};
+      CHECK(resource.allocated == 2);
+    }
+    CHECK(resource.deallocated == 2);
+
+    counting_resource other;
+    {
+      fn::box<List> a{std::allocator_arg, &resource, List{{Json{0.5}}}};
+      fn::box<List> const b{std::allocator_arg, &other, List{}};
+      a = b;
+      CHECK(a.get_allocator().resource() == &resource);
+      CHECK(*a == List{});
+      CHECK(other.allocated == 1);
+
+      fn::box<List> c{std::move(a)};
+      a = b;
+      CHECK(a.get_allocator().resource() == &other);
+    }
+    CHECK(resource.allocated == resource.deallocated);
+    CHECK(other.allocated == other.deallocated);
+
+    fn::box<int> const d{12};
+    CHECK(d.get_allocator().resource() == std::pmr::get_default_resource());
+  }
+}
+
+TEST_CASE("box in sum", "[box][sum][choice]")
+{
+  Json const json{fn::box<List>{List{{Json{0.5}, Json{std::string("abc")}, Json{fn::box<List>{List{}}}}}}};
+  static_assert(fn::typelist_invocable<decltype([](List const &) {}), fn::sum<fn::box<List>> const &>);
+  static_assert(not fn::typelist_invocable<decltype([](fn::box<List> const &) {}), fn::sum<fn::box<List>> const &>);
+
+  WHEN("invoke")
+  {
+    constexpr auto size = fn::overload{[](double) -> std::size_t { return 1; },
+                                       [](std::string const &s) -> std::size_t { return s.size(); },
+                                       [](List const &l) -> std::size_t { return l.items.size(); }};
+    CHECK(json.invoke(size) == 3);
+    CHECK(json.value().invoke(size) == 3);
+    CHECK(json.invoke_r<int>(size) == 3);
+    CHECK(json.invoke([]<typename T>(std::in_place_type_t<T>, T const &) { return std::is_same_v<T, List>; }));
+    CHECK(json.invoke([](auto const &v) { return std::is_same_v<decltype(v), List const &>; }));
+    CHECK(json.invoke([&json](auto const &v) -> bool {
+      return static_cast<void const *>(&v) == json.get_ptr<fn::box<List>>()->get();
+    }));
+
+    CHECK(json.has_value<fn::box<List>>());
+    CHECK(json == Json{fn::box<List>{List{{Json{0.5}, Json{std::string("abc")}, Json{fn::box<List>{List{}}}}}}});
+  }
+
+  WHEN("move")
+  {
+    Json copy = json;
+    List const *const p = copy.get_ptr<fn::box<List>>()->get();
+    CHECK(std::move(copy).invoke([p](auto &&v) {
+      return std::is_same_v<decltype(v), List &&> && static_cast<void const *>(&v) == p;
+    }));
+  }
+
+  WHEN("transform")
+  {
+    fn::sum<fn::box<List>> const s{fn::box<List>{List{}}};
+    auto const r = s.transform([](List const &l) { return l.items.size(); });
+    static_assert(std::is_same_v<decltype(r), fn::sum<std::size_t> const>);
+    CHECK(r == fn::sum<std::size_t>{0ul});
+
+    auto const c = json.transform(fn::overload{[](double d) { return d; }, [](std::string const &) { return 0.0; },
+                                               [](List const &l) { return l.items.size(); }});
+    static_assert(std::is_same_v<decltype(c), fn::choice<double, std::size_t> const>);
+    CHECK(c == fn::choice<double, std::size_t>{3ul});
+  }
+
+  WHEN("recursive")
+  {
+    Tree const t{fn::box<Branch>{Branch{Tree{1}, Tree{fn::box<Branch>{Branch{Tree{2}, Tree{3}}}}}}};
+    CHECK(total(t) == 6);
+  }
+}
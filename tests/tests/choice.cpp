@@ -8,6 +8,9 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <cstdint>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 namespace {
@@ -61,6 +64,58 @@ TEST_CASE("choice non-monadic functionality", "[choice]")
     CHECK((std::move(s).value().invoke(fn)) == 45);
   }
 
+  WHEN("size")
+  {
+    static_assert(std::same_as<choice<bool, int>::index_t, std::uint8_t>);
+    static_assert(sizeof(choice<bool>) == 2);
+    static_assert(sizeof(choice<float, int>) == 8);
+    static_assert(sizeof(choice<double, int>) == 16);
+  }
+
+  WHEN("trivial")
+  {
+    using type = choice<double, int>;
+    static_assert(std::is_trivially_copyable_v<type>);
+    static_assert(std::is_trivially_copy_constructible_v<type>);
+    static_assert(std::is_trivially_move_constructible_v<type>);
+    static_assert(std::is_trivially_destructible_v<type>);
+
+    // Some alternatives are not trivial
+    static_assert(not std::is_trivially_copyable_v<choice<TestType, int>>);
+    static_assert(not std::is_trivially_destructible_v<choice<TestType, int>>);
+    static_assert(std::is_copy_constructible_v<choice<TestType, int>>);
+    static_assert(std::is_trivially_destructible_v<choice<NonCopyable, int>>);
+    static_assert(not std::is_copy_constructible_v<choice<NonCopyable, int>>);
+
+    type a{12.5};
+    type b = a;
+    CHECK(*b.value().get_ptr(std::in_place_type<double>) == 12.5);
+  }
+
+  WHEN("assignment")
+  {
+    static_assert(std::is_trivially_copy_assignable_v<choice<double, int>>);
+    static_assert(std::is_trivially_move_assignable_v<choice<double, int>>);
+    static_assert(not std::is_copy_assignable_v<choice<NonCopyable, int>>);
+
+    TestType::count = 0;
+    {
+      using type = choice<TestType, int>;
+      type a{std::in_place_type<TestType>};
+      type const b{12};
+      CHECK(TestType::count == 1);
+      a = b;
+      CHECK(TestType::count == 0);
+      CHECK(*a.value().get_ptr(std::in_place_type<int>) == 12);
+      a.emplace<TestType>();
+      CHECK(TestType::count == 1);
+      a.emplace<int>(3);
+      CHECK(TestType::count == 0);
+      CHECK(*a.value().get_ptr(std::in_place_type<int>) == 3);
+    }
+    CHECK(TestType::count == 0);
+  }
+
   WHEN("choice_for")
   {
     static_assert(std::same_as<fn::choice_for<int>, fn::choice<int>>);
@@ -870,3 +925,21 @@ TEST_CASE("choice transform", "[choice][transform]")
     }
   }
 }
+
+TEST_CASE("choice exception specification", "[choice][noexcept]")
+{
+  using type = fn::choice_for<int, std::string>;
+  static_assert(std::is_nothrow_move_constructible_v<type>);
+  static_assert(std::is_nothrow_move_assignable_v<type>);
+  static_assert(not std::is_nothrow_copy_constructible_v<type>);
+  static_assert(std::is_nothrow_copy_constructible_v<fn::choice<bool, int>>);
+
+  type s{12};
+  constexpr auto nothrow = [](auto const &) noexcept { return 1; };
+  constexpr auto throwing = [](auto const &) -> int { throw 0; };
+  static_assert(noexcept(s.transform(nothrow)));
+  static_assert(not noexcept(s.transform(throwing)));
+  static_assert(noexcept(s.and_then([](auto const &) noexcept { return fn::choice<int>{1}; })));
+  static_assert(not noexcept(s.and_then([](auto const &) { return fn::choice<int>{1}; })));
+  CHECK_THROWS_AS(s.transform(throwing), int);
+}
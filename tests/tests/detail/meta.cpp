@@ -8,6 +8,7 @@
 #include <catch2/catch_all.hpp>
 
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -40,6 +41,20 @@ TEST_CASE("type index", "[type_index]")
   SUCCEED();
 }
 
+TEST_CASE("select index", "[select_index]")
+{
+  using namespace fn::detail;
+
+  static_assert(std::same_as<select_index_t<1>, std::uint8_t>);
+  static_assert(std::same_as<select_index_t<2>, std::uint8_t>);
+  static_assert(std::same_as<select_index_t<255>, std::uint8_t>);
+  static_assert(std::same_as<select_index_t<256>, std::uint16_t>);
+  static_assert(std::same_as<select_index_t<65535>, std::uint16_t>);
+  static_assert(std::same_as<select_index_t<65536>, std::uint32_t>);
+
+  SUCCEED();
+}
+
 namespace {
 template <typename... Ts> struct type_list {};
 template <typename... Ts> struct types {};
@@ -91,6 +106,13 @@ TEST_CASE("normalized", "[normalized]")
   static_assert(type_sortkey_v<int> == "int");
   static_assert(type_sortkey_v<decltype(0)> == "int");
   static_assert(type_sortkey_v<_ts<bool, int>> == "fn::detail::_ts<bool, int>");
+  static_assert(_sortkey<int>::words[0] == 0x696e740000000000);
+  static_assert(_sortkey<_ts<bool>>::words[0] == _sortkey<_ts<int>>::words[0]);
+
+  // Names with the same first word are ordered by the remaining words, in lexicographic order
+  static_assert(std::same_as<types<_ts<bool, int>, _ts<bool>, _ts<int>>,
+                             normalized<_ts<int>, _ts<bool>, _ts<bool, int>, _ts<bool>>::apply<types>>);
+  static_assert(normalized<_ts<int>, _ts<bool>, _ts<bool, int>, _ts<bool>>::size == 3);
 
   SUCCEED();
 }
@@ -45,6 +45,18 @@ TEST_CASE("variadic_union", "[variadic_union][invoke_variadic_union][ptr_variadi
   constexpr T6 a4 = make_variadic_union<NonCopyable, T6>(42);
   static_assert(ptr_variadic_union<NonCopyable, T6>(a4)->v == 42);
 
+  static_assert(std::is_trivially_copyable_v<variadic_union<int>>);
+  static_assert(std::is_trivially_copyable_v<variadic_union<int, double>>);
+  static_assert(std::is_trivially_copyable_v<variadic_union<int, double, bool>>);
+  static_assert(std::is_trivially_copyable_v<variadic_union<int, double, bool, char>>);
+  static_assert(std::is_trivially_copyable_v<variadic_union<int, double, bool, char, float, long>>);
+  static_assert(std::is_trivially_destructible_v<T6>);
+  static_assert(not std::is_trivially_destructible_v<variadic_union<std::string>>);
+  static_assert(not std::is_trivially_destructible_v<variadic_union<int, std::string>>);
+  static_assert(not std::is_trivially_destructible_v<variadic_union<int, double, std::string>>);
+  static_assert(not std::is_trivially_destructible_v<variadic_union<int, double, bool, std::string>>);
+  static_assert(not std::is_trivially_destructible_v<variadic_union<int, double, bool, char, float, std::string>>);
+
   using U1 = variadic_union<bool>;
   constexpr U1 b1 = make_variadic_union<bool, U1>(true);
   static_assert(decltype(b1)::has_type<bool>);
@@ -424,3 +436,121 @@ TEST_CASE("variadic_unionc invoke only", "[variadic_union][invoke_variadic_union
     }
   }
 }
+
+TEST_CASE("variadic_union invoke dispatch", "[variadic_union][invoke_variadic_union][dispatch]")
+{
+  using fn::detail::_invoke_chain_tag;
+  using fn::detail::_invoke_select_tag;
+  using fn::detail::_invoke_table_tag;
+  using fn::detail::invoke_variadic_union;
+  using fn::detail::make_variadic_union;
+  using fn::detail::variadic_union;
+
+  using type = variadic_union<char, short, int, long, long long, unsigned char, unsigned short, unsigned, unsigned long,
+                              unsigned long long>;
+  static_assert(type::size == 10);
+  static_assert(std::same_as<_invoke_select_tag<type>, _invoke_chain_tag>);
+  using wide_type = decltype([]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::type_identity<variadic_union<std::integral_constant<std::size_t, Is>...>>{};
+  }(std::make_index_sequence<17>{}))::type;
+  static_assert(wide_type::size == 17);
+  static_assert(std::same_as<_invoke_select_tag<wide_type>, _invoke_table_tag>);
+  static_assert(std::same_as<_invoke_select_tag<variadic_union<int, short>>, _invoke_chain_tag>);
+  static_assert(std::same_as<_invoke_select_tag<variadic_union<int, short, long, char, bool>>, _invoke_chain_tag>);
+
+  constexpr auto fn1 = [](auto i) -> int { return static_cast<int>(i) + sizeof(i); };
+  constexpr auto fn2 = []<typename T>(std::in_place_type_t<T>, auto i) -> int {
+    static_assert(std::same_as<T, decltype(i)>);
+    return static_cast<int>(i) * 2;
+  };
+  constexpr auto fn3 = fn::overload{[](auto &) -> int { return 1; }, [](auto const &) -> int { return 2; },
+                                    [](auto &&) -> int { return 3; }, [](auto const &&) -> int { return 4; }};
+
+  constexpr type a = make_variadic_union<unsigned short, type>(static_cast<unsigned short>(12));
+  static_assert(invoke_variadic_union<int, type, _invoke_table_tag>(a, 6, fn1) == 14);
+  static_assert(invoke_variadic_union<int, type, _invoke_chain_tag>(a, 6, fn1) == 14);
+  static_assert(invoke_variadic_union<int, type, _invoke_table_tag>(a, 6, fn2) == 24);
+  static_assert(invoke_variadic_union<int, type, _invoke_chain_tag>(a, 6, fn2) == 24);
+  static_assert(invoke_variadic_union<int, type>(a, 6, fn2) == 24);
+
+  WHEN("value categories")
+  {
+    auto v = make_variadic_union<long, type>(3l);
+    CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(v, 3, fn3) == 1);
+    CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(std::as_const(v), 3, fn3) == 2);
+    CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(std::move(v), 3, fn3) == 3);
+    CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(std::move(std::as_const(v)), 3, fn3) == 4);
+  }
+
+  WHEN("every index")
+  {
+    auto const check = [&]<typename T>(std::in_place_type_t<T>) {
+      constexpr std::size_t index = fn::detail::type_index<T, char, short, int, long, long long, unsigned char,
+                                                           unsigned short, unsigned, unsigned long, unsigned long long>;
+      auto const v = make_variadic_union<T, type>(static_cast<T>(index));
+      CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(v, index, fn1)
+            == invoke_variadic_union<int, type, _invoke_chain_tag>(v, index, fn1));
+      CHECK(invoke_variadic_union<int, type, _invoke_table_tag>(v, index, fn2) == static_cast<int>(index * 2));
+
+      int total = 0;
+      invoke_variadic_union<void, type, _invoke_table_tag>(v, index, [&total](auto i) { total += i; });
+      CHECK(total == static_cast<int>(index));
+      invoke_variadic_union<void, type, _invoke_table_tag>(
+          v, index, [&total](fn::some_in_place_type auto, auto i) { total += 2 * i; });
+      CHECK(total == static_cast<int>(index * 3));
+    };
+    check(std::in_place_type<char>);
+    check(std::in_place_type<short>);
+    check(std::in_place_type<int>);
+    check(std::in_place_type<long>);
+    check(std::in_place_type<long long>);
+    check(std::in_place_type<unsigned char>);
+    check(std::in_place_type<unsigned short>);
+    check(std::in_place_type<unsigned>);
+    check(std::in_place_type<unsigned long>);
+    check(std::in_place_type<unsigned long long>);
+  }
+}
+
+TEST_CASE("variadic_union many alternatives", "[variadic_union][invoke_variadic_union]")
+{
+  using fn::detail::_invoke_chain_tag;
+  using fn::detail::_invoke_table_tag;
+  using fn::detail::invoke_variadic_union;
+  using fn::detail::make_variadic_union;
+  using fn::detail::ptr_variadic_union;
+  using fn::detail::variadic_union;
+
+  constexpr std::size_t size = 40;
+  using type = decltype([]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::type_identity<variadic_union<std::integral_constant<std::size_t, Is>...>>{};
+  }(std::make_index_sequence<size>{}))::type;
+
+  static_assert(type::size == size);
+  static_assert(type::has_type<std::integral_constant<std::size_t, 0>>);
+  static_assert(type::has_type<std::integral_constant<std::size_t, size - 1>>);
+  static_assert(not type::has_type<std::integral_constant<std::size_t, size>>);
+  // NOTE Alternatives after the first 4 are split in halves, rather than nested one level per 4 alternatives
+  static_assert(fn::detail::_is_variadic_union_node<type::more_t>);
+  static_assert(type::more_t::lo_t::size == 18);
+  static_assert(type::more_t::hi_t::size == 18);
+  static_assert(std::same_as<variadic_union<int, bool, char, long, short>::more_t, variadic_union<short>>);
+  static_assert(std::is_trivially_destructible_v<type>);
+
+  constexpr auto fn1 = [](auto i) -> std::size_t { return decltype(i)::value; };
+  constexpr auto fn2 = []<typename T>(std::in_place_type_t<T>, auto const &) -> std::size_t { return T::value * 2; };
+
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    auto const check = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      using T = std::integral_constant<std::size_t, I>;
+      constexpr type v = make_variadic_union<T, type>();
+      static_assert(std::same_as<decltype(ptr_variadic_union<T, type>(v)), T const *>);
+      static_assert(ptr_variadic_union<T, type>(v) != nullptr);
+      static_assert(invoke_variadic_union<std::size_t, type, _invoke_table_tag>(v, I, fn1) == I);
+      static_assert(invoke_variadic_union<std::size_t, type, _invoke_chain_tag>(v, I, fn1) == I);
+      static_assert(invoke_variadic_union<std::size_t, type>(v, I, fn2) == I * 2);
+      CHECK(invoke_variadic_union<std::size_t, type, _invoke_chain_tag>(v, I, fn2) == I * 2);
+    };
+    (check(std::integral_constant<std::size_t, Is>{}), ...);
+  }(std::make_index_sequence<size>{});
+}
@@ -4,15 +4,42 @@
 // or copy at https://opensource.org/licenses/ISC
 
 #include "functional/expected.hpp"
+#include "functional/transform.hpp"
 #include "functional/utility.hpp"
 
 #include <catch2/catch_all.hpp>
 
+#include <concepts>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 namespace {
 enum Error { Unknown, FileNotFound };
-}
+
+struct ThrowingCopy final {
+  int value;
+
+  constexpr explicit ThrowingCopy(int v) noexcept : value(v) {}
+  ThrowingCopy(ThrowingCopy const &other) noexcept(false) : value(other.value) {}
+  ThrowingCopy(ThrowingCopy &&other) noexcept = default;
+};
+
+// NOTE Counts copies and moves, to check that operator& does not move values into a new pack at every step
+struct Counted final {
+  static int copies;
+  static int moves;
+  int value;
+
+  constexpr explicit Counted(int v) noexcept : value(v) {}
+  Counted(Counted const &other) noexcept : value(other.value) { ++copies; }
+  Counted(Counted &&other) noexcept : value(other.value) { ++moves; }
+};
+int Counted::copies = 0;
+int Counted::moves = 0;
+
+using counted_t = fn::expected<Counted, Error>;
+} // namespace
 
 TEST_CASE("expected pack support", "[expected][pack][and_then][transform][operator_and]")
 {
@@ -235,8 +262,9 @@ TEST_CASE("expected pack support", "[expected][pack][and_then][transform][operat
     WHEN("value & value yield pack")
     {
       static_assert(
-          std::same_as<decltype(std::declval<fn::expected<int, Error>>() & std::declval<fn::expected<double, Error>>()),
-                       fn::expected<fn::pack<int, double>, Error>>);
+          std::same_as<
+              decltype(std::declval<fn::expected<int, Error>>() & std::declval<fn::expected<double, Error>>())::type,
+              fn::expected<fn::pack<int, double>, Error>>);
 
       CHECK((fn::expected<double, Error>{0.5} //
              & fn::expected<int, Error>{12})
@@ -259,7 +287,7 @@ TEST_CASE("expected pack support", "[expected][pack][and_then][transform][operat
     WHEN("pack & value yield pack")
     {
       static_assert(std::same_as<decltype(std::declval<fn::expected<fn::pack<double, bool>, Error>>()
-                                          & std::declval<fn::expected<int, Error>>()),
+                                          & std::declval<fn::expected<int, Error>>())::type,
                                  fn::expected<fn::pack<double, bool, int>, Error>>);
 
       CHECK((fn::expected<fn::pack<double, bool>, Error>{std::in_place, fn::pack<double, bool>{0.5, true}} //
@@ -344,6 +372,145 @@ TEST_CASE("expected pack support", "[expected][pack][and_then][transform][operat
                                       fn::expected<fn::pack<double, bool>, Error>{fn::pack<double, bool>{0.5, true}},
                                       fn::expected<fn::pack<double, bool>, Error>{fn::pack<double, bool>{0.5, true}}));
     }
+
+    WHEN("result is kept")
+    {
+      constexpr auto make_a = [] { return fn::expected<std::string, Error>{"abc"}; };
+      constexpr auto make_b = [] { return fn::expected<std::string, Error>{"de"}; };
+      auto r = make_a() & make_b();
+      auto s = r & fn::expected<void, Error>{} & make_b();
+      CHECK(r.value().invoke([](auto const &a, auto const &b) { return a + b; }) == "abcde");
+      CHECK(s.value().invoke([](auto const &...v) { return (std::string{} + ... + v); }) == "abcdede");
+    }
+
+    WHEN("chain of values")
+    {
+      using type = fn::expected<fn::pack<Counted, Counted, Counted, Counted, Counted>, Error>;
+      static_assert(std::same_as<decltype(std::declval<counted_t>() & std::declval<counted_t>()
+                                          & std::declval<fn::expected<void, Error>>() & std::declval<counted_t>()
+                                          & std::declval<counted_t>() & std::declval<counted_t>())::type,
+                                 type>);
+      Counted::copies = 0;
+      Counted::moves = 0;
+
+      WHEN("lvalue operands")
+      {
+        counted_t const a{1};
+        counted_t b{2};
+        counted_t const c{3};
+        counted_t const d{4};
+        counted_t const e{5};
+
+        WHEN("materialized")
+        {
+          type const r = a & b & c & d & e;
+          CHECK(r.has_value());
+          CHECK(Counted::copies == 5);
+          CHECK(Counted::moves == 0);
+        }
+
+        WHEN("transform")
+        {
+          auto const r = (a & b & c & d & e).transform([](auto const &...v) { return (0 + ... + v.value); });
+          CHECK(r.value() == 15);
+          CHECK(Counted::copies == 0);
+          CHECK(Counted::moves == 0);
+        }
+
+        WHEN("and_then")
+        {
+          auto const r = (a & b & fn::expected<void, Error>{} & c & d & e)
+                             .and_then([](auto const &...v) -> fn::expected<int, Error> { //
+                               return (0 + ... + v.value);
+                             });
+          CHECK(r.value() == 15);
+          CHECK(Counted::copies == 0);
+          CHECK(Counted::moves == 0);
+        }
+
+        WHEN("functor")
+        {
+          auto const r = a & b & c & d & e | fn::transform([](auto const &...v) { return (0 + ... + v.value); });
+          CHECK(r.value() == 15);
+          CHECK(Counted::copies == 5);
+          CHECK(Counted::moves == 0);
+        }
+
+        WHEN("result is kept")
+        {
+          auto const r = a & b & c;
+          auto const s = r & d & e;
+          b.value().value = 12;
+          type const t = s;
+          CHECK(t.value().invoke([](auto const &...v) { return (0 + ... + v.value); }) == 25);
+          CHECK(Counted::copies == 5);
+          CHECK(Counted::moves == 0);
+        }
+      }
+
+      WHEN("rvalue operands")
+      {
+        // NOTE Owned by the result of the first operator& which takes them, and moved by each following operator&
+        WHEN("materialized")
+        {
+          fn::expected<fn::pack<Counted, Counted, Counted>, Error> const r
+              = counted_t{1} & counted_t{2} & counted_t{3};
+          CHECK(r.has_value());
+          CHECK(Counted::copies == 0);
+          CHECK(Counted::moves == 3 + 3 + 2);
+        }
+
+        WHEN("transform")
+        {
+          auto const r
+              = (counted_t{1} & counted_t{2}).transform([](auto const &...v) { return (0 + ... + v.value); });
+          CHECK(r.value() == 3);
+          CHECK(Counted::copies == 0);
+          CHECK(Counted::moves == 1 + 1);
+        }
+      }
+
+      WHEN("first error")
+      {
+        counted_t const a{1};
+        counted_t const b{std::unexpect, FileNotFound};
+        CHECK((a & b & fn::expected<void, Error>{std::unexpect, Unknown} & a).error() == FileNotFound);
+        CHECK((a & a & fn::expected<void, Error>{std::unexpect, Unknown} & b)
+                  .transform([](auto &&...) { return 0; })
+                  .error()
+              == Unknown);
+        type const r = a & a & a & a & counted_t{std::unexpect, Unknown};
+        CHECK(r.error() == Unknown);
+        CHECK(Counted::copies == 0);
+        CHECK(Counted::moves == 0);
+      }
+    }
+
+    WHEN("noexcept")
+    {
+      using throwing_t = fn::expected<ThrowingCopy, Error>;
+      using type = fn::expected<fn::pack<ThrowingCopy, int>, Error>;
+      static_assert(noexcept(std::declval<fn::expected<int, Error>>() & std::declval<fn::expected<double, Error>>()));
+      static_assert(noexcept(std::declval<fn::expected<int, Error> const &>()
+                             & std::declval<fn::expected<void, Error> const &>()));
+      static_assert(not noexcept(std::declval<throwing_t &>() & std::declval<fn::expected<void, Error>>()));
+
+      // NOTE operator& only refers to lvalue operands, their values are copied when the result is consumed
+      using ref_t = decltype(std::declval<throwing_t const &>() & std::declval<fn::expected<int, Error>>());
+      static_assert(noexcept(std::declval<throwing_t const &>() & std::declval<fn::expected<int, Error>>()));
+      static_assert(not std::is_nothrow_convertible_v<ref_t, type>);
+      using pack_ref_t = decltype(std::declval<fn::expected<fn::pack<ThrowingCopy>, Error> &>()
+                                  & std::declval<fn::expected<int, Error>>());
+      static_assert(not std::is_nothrow_convertible_v<pack_ref_t, type>);
+
+      // NOTE ... and rvalue operands are moved into the result, which copies them when it is an lvalue
+      using own_t = decltype(std::declval<throwing_t>() & std::declval<fn::expected<int, Error>>());
+      static_assert(noexcept(std::declval<throwing_t>() & std::declval<fn::expected<int, Error>>()));
+      static_assert(std::is_nothrow_convertible_v<own_t, type>);
+      static_assert(not std::is_nothrow_convertible_v<own_t const &, type>);
+      static_assert(noexcept(std::declval<own_t>() & std::declval<fn::expected<void, Error>>()));
+      static_assert(not noexcept(std::declval<own_t const &>() & std::declval<fn::expected<void, Error>>()));
+    }
   }
 }
 
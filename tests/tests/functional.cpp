@@ -109,6 +109,90 @@ TEST_CASE("is_invocable_r sum", "[is_invocable_r][sum]")
   SUCCEED();
 }
 
+TEST_CASE("is_nothrow_invocable pack", "[is_nothrow_invocable][pack]")
+{
+  using fn::is_nothrow_invocable;
+  using fn::is_nothrow_invocable_v;
+  using fn::pack;
+
+  constexpr pack<int, double> p{3, 14.15};
+  constexpr auto fn1 = [](int i, double j) noexcept -> int { return i * 100 + (int)j; };
+  static_assert(is_nothrow_invocable<decltype(fn1), decltype(p)>::value);
+  static_assert(is_nothrow_invocable_v<decltype(fn1), decltype(p)>);
+  constexpr auto fn2 = [](int i, double j) -> int { return i * 100 + (int)j; };
+  static_assert(fn::is_invocable_v<decltype(fn2), decltype(p)>);
+  static_assert(not is_nothrow_invocable<decltype(fn2), decltype(p)>::value);
+  static_assert(not is_nothrow_invocable_v<decltype(fn2), decltype(p)>);
+  constexpr auto fn3 = [](int, double &) noexcept -> int { return 0; };
+  static_assert(not is_nothrow_invocable_v<decltype(fn3), decltype(p)>);
+}
+
+TEST_CASE("is_nothrow_invocable sum", "[is_nothrow_invocable][sum]")
+{
+  using fn::is_nothrow_invocable;
+  using fn::is_nothrow_invocable_v;
+  using fn::overload;
+  using fn::sum;
+
+  constexpr sum<double, int> p{3};
+  constexpr auto fn1
+      = overload{[](int i) noexcept -> int { return i * 100; }, [](double j) noexcept -> int { return (int)j; }};
+  static_assert(is_nothrow_invocable<decltype(fn1), decltype(p)>::value);
+  static_assert(is_nothrow_invocable_v<decltype(fn1), decltype(p)>);
+  constexpr auto fn2 = overload{[](int i) noexcept -> int { return i * 100; }, [](double j) -> int { return (int)j; }};
+  static_assert(fn::is_invocable_v<decltype(fn2), decltype(p)>);
+  static_assert(not is_nothrow_invocable<decltype(fn2), decltype(p)>::value);
+  static_assert(not is_nothrow_invocable_v<decltype(fn2), decltype(p)>);
+  constexpr auto fn3 = [](int &) noexcept -> int { return 0; };
+  static_assert(not is_nothrow_invocable_v<decltype(fn3), decltype(p)>);
+}
+
+TEST_CASE("is_nothrow_invocable_r pack", "[is_nothrow_invocable_r][pack]")
+{
+  using fn::is_nothrow_invocable_r;
+  using fn::is_nothrow_invocable_r_v;
+  using fn::pack;
+
+  struct Throwing final {
+    Throwing(int) {}
+  };
+
+  constexpr pack<int, double> p{3, 14.15};
+  constexpr auto fn1 = [](int i, double j) noexcept -> int { return i * 100 + (int)j; };
+  static_assert(is_nothrow_invocable_r<bool, decltype(fn1), decltype(p)>::value);
+  static_assert(is_nothrow_invocable_r_v<bool, decltype(fn1), decltype(p)>);
+  static_assert(fn::is_invocable_r_v<Throwing, decltype(fn1), decltype(p)>);
+  static_assert(not is_nothrow_invocable_r_v<Throwing, decltype(fn1), decltype(p)>);
+  static_assert(not is_nothrow_invocable_r_v<int *, decltype(fn1), decltype(p)>);
+  constexpr auto fn2 = [](int i, double j) -> int { return i * 100 + (int)j; };
+  static_assert(not is_nothrow_invocable_r<bool, decltype(fn2), decltype(p)>::value);
+  static_assert(not is_nothrow_invocable_r_v<bool, decltype(fn2), decltype(p)>);
+}
+
+TEST_CASE("is_nothrow_invocable_r sum", "[is_nothrow_invocable_r][sum]")
+{
+  using fn::is_nothrow_invocable_r;
+  using fn::is_nothrow_invocable_r_v;
+  using fn::overload;
+  using fn::sum;
+
+  struct Throwing final {
+    Throwing(int) {}
+  };
+
+  constexpr sum<double, int> p{3};
+  constexpr auto fn1
+      = overload{[](int i) noexcept -> int { return i * 100; }, [](double j) noexcept -> int { return (int)j; }};
+  static_assert(is_nothrow_invocable_r<bool, decltype(fn1), decltype(p)>::value);
+  static_assert(is_nothrow_invocable_r_v<bool, decltype(fn1), decltype(p)>);
+  static_assert(fn::is_invocable_r_v<Throwing, decltype(fn1), decltype(p)>);
+  static_assert(not is_nothrow_invocable_r_v<Throwing, decltype(fn1), decltype(p)>);
+  static_assert(not is_nothrow_invocable_r_v<int *, decltype(fn1), decltype(p)>);
+  constexpr auto fn2 = overload{[](int i) -> int { return i * 100; }, [](double j) noexcept -> int { return (int)j; }};
+  static_assert(not is_nothrow_invocable_r<bool, decltype(fn2), decltype(p)>::value);
+  static_assert(not is_nothrow_invocable_r_v<bool, decltype(fn2), decltype(p)>);
+}
+
 TEST_CASE("invoke polyfill", "[invoke][polyfill]")
 {
   using fn::invoke;
@@ -146,4 +230,30 @@ TEST_CASE("invoke pack", "[invoke][pack]")
   CHECK(invoke(fn, std::move(p)) == 314);
 }
 
-TEST_CASE("invoke sum", "[invoke][sum]") {}
+TEST_CASE("invoke sum", "[invoke][sum]")
+{
+  using fn::invoke;
+  using fn::sum;
+
+  constexpr auto fn = fn::overload{[](int i) -> int { return i; }, [](double d) -> int { return (int)(d * 10); }};
+  sum<double, int> a{42};
+  CHECK(invoke(fn, a) == 42);
+  CHECK(invoke(fn, sum<double, int>{0.5}) == 5);
+
+  WHEN("several sums")
+  {
+    constexpr auto fn2 = [](auto i, auto j) -> int { return (int)(i * 100 + j); };
+    sum<double, int> b{3};
+    sum<bool, int> c{true};
+    static_assert(std::same_as<decltype(invoke(fn2, a, b)), int>);
+    CHECK(invoke(fn2, a, b) == 4203);
+    CHECK(invoke(fn2, std::as_const(a), std::move(b)) == 4203);
+    CHECK(invoke(fn2, b, c) == 301);
+    CHECK(invoke([](auto i, auto j, auto k) -> int { return (int)(i * 100 + j * 10 + k); }, a, b, c) == 4231);
+    static_assert(invoke(fn2, sum<double, int>{1}, sum<bool, int>{2}) == 102);
+
+    // Direct invocation of several sums is not visitation
+    constexpr auto direct = [](fn::some_sum auto const &, fn::some_sum auto const &) {};
+    static_assert([](auto &&a) -> bool { return not requires { invoke(direct, a, a); }; }(sum<double, int>{1}));
+  }
+}
@@ -5,11 +5,21 @@
 
 #include "static_check.hpp"
 
+#include "functional/and_then.hpp"
+#include "functional/filter.hpp"
 #include "functional/functor.hpp"
+#include "functional/inspect.hpp"
+#include "functional/or_else.hpp"
+#include "functional/pack.hpp"
+#include "functional/transform.hpp"
 #include "functional/utility.hpp"
 
 #include <catch2/catch_all.hpp>
 
+#include <string>
+#include <type_traits>
+#include <utility>
+
 using namespace util;
 
 namespace {
@@ -50,3 +60,152 @@ TEST_CASE("user-defined monadic operation", "[functor]")
   CHECK((fn::expected<int, std::runtime_error>{12} | dummy(fn1)).value() == 13);
   CHECK((fn::optional{42} | dummy(fn1)).value() == 43);
 }
+
+TEST_CASE("stateless functor takes no storage", "[functor][pack]")
+{
+  constexpr auto inc = [](int i) { return i + 1; };
+  constexpr auto positive = [](int i) { return i > 0; };
+  constexpr auto half = [](int i) { return fn::optional<int>{i / 2}; };
+
+  static_assert(std::is_empty_v<decltype(dummy(fn1))>);
+  static_assert(std::is_empty_v<decltype(fn::transform(inc))>);
+  static_assert(std::is_empty_v<decltype(fn::and_then(half))>);
+  static_assert(std::is_empty_v<decltype(fn::filter(positive))>);
+
+  // NOTE Only the state of the functions is stored
+  int const offset = 12;
+  auto const add = [offset](int i) { return i + offset; };
+  static_assert(sizeof(fn::transform(auto(add))) == sizeof(int));
+  static_assert(sizeof(fn::filter(positive, auto(add))) == sizeof(int));
+  static_assert(sizeof(fn::transform(add)) == sizeof(&add)); // NOTE Non-empty lvalue is stored as a reference
+
+  // NOTE Stateless functors kept for later use take no storage, so a pipeline is only as large as its state
+  auto const pipeline
+      = fn::pack{fn::filter(positive), fn::transform(inc), fn::and_then(half), fn::transform(auto(add))};
+  static_assert(sizeof(pipeline) == sizeof(int));
+  constexpr auto apply = [](fn::optional<int> v, auto const &...fns) {
+    return (v | ... | fns); // NOTE Left fold, i.e. functors applied in order
+  };
+  CHECK(pipeline.invoke(apply, fn::optional<int>{6}).value() == 15);
+  CHECK(not pipeline.invoke(apply, fn::optional<int>{-6}).has_value());
+}
+
+namespace {
+struct Counted final {
+  static int moves;
+  int value;
+
+  constexpr explicit Counted(int v) noexcept : value(v) {}
+  Counted(Counted const &) = delete;
+  Counted(Counted &&other) noexcept : value(other.value) { ++moves; }
+};
+int Counted::moves = 0;
+} // namespace
+
+TEST_CASE("pipeline", "[functor][pipeline]")
+{
+  using type = fn::expected<int, std::string>;
+  constexpr auto half = [](int i) -> type {
+    if (i % 2 != 0)
+      return std::unexpected<std::string>("odd");
+    return {i / 2};
+  };
+  constexpr auto inc = [](int i) { return i + 1; };
+  constexpr auto positive = [](int i) { return i > 0; };
+  constexpr auto error = [](int i) { return std::to_string(i); };
+
+  auto const p = fn::and_then(half) | fn::transform(inc) | fn::filter(positive, error);
+  static_assert(std::same_as<decltype(p), fn::pipeline<fn::functor<fn::and_then_t, decltype(half) const &>,
+                                                        fn::functor<fn::transform_t, decltype(inc) const &>,
+                                                        fn::functor<fn::filter_t, decltype(positive) const &,
+                                                                    decltype(error) const &>> const>);
+  static_assert(std::is_empty_v<decltype(p)>);
+
+  WHEN("same result as functors applied one by one")
+  {
+    auto const sequential = [&](type v) {
+      return v | fn::and_then(half) | fn::transform(inc) | fn::filter(positive, error);
+    };
+    for (type v : {type{12}, type{7}, type{-2}, type{0}, type{std::unexpect, "error"}}) {
+      static_assert(std::same_as<decltype(v | p), decltype(sequential(v))>);
+      constexpr auto same = [](type const &lh, type const &rh) {
+        return lh.has_value() ? rh.has_value() && lh.value() == rh.value()
+                              : not rh.has_value() && lh.error() == rh.error();
+      };
+      CHECK(same(v | p, sequential(v)));
+      CHECK(same(type(v) | p, sequential(v)));
+    }
+    CHECK((type{12} | p).value() == 7);
+    CHECK((type{7} | p).error() == "odd");
+    CHECK((type{-2} | p).error() == "0");
+    CHECK((type{std::unexpect, "error"} | p).error() == "error");
+  }
+
+  WHEN("error skips remaining stages")
+  {
+    int count = 0;
+    auto const q = fn::transform(inc) | fn::inspect([&count](int) { ++count; }) | fn::and_then(half)
+                   | fn::inspect([&count](int) { ++count; });
+    static_assert(std::same_as<decltype(type{1} | q), type>); // NOTE Not a reference to an intermediate result
+    CHECK((type{1} | q).value() == 1);
+    CHECK(count == 2);
+    CHECK((type{2} | q).error() == "odd");
+    CHECK(count == 3);
+    CHECK((type{std::unexpect, "error"} | q).error() == "error");
+    CHECK(count == 3);
+  }
+
+  WHEN("optional")
+  {
+    auto const q = fn::transform(inc) | fn::filter(positive) | fn::and_then([](int i) { return fn::optional{i * 2}; });
+    CHECK((fn::optional{2} | q).value() == 6);
+    static_assert((fn::optional{2} | (fn::transform(inc) | fn::filter(positive))).value() == 3);
+    CHECK(not(fn::optional{-2} | q).has_value());
+    CHECK(not(fn::optional<int>{} | q).has_value());
+  }
+
+  WHEN("void")
+  {
+    using type = fn::expected<void, std::string>;
+    int count = 0;
+    auto const q = fn::inspect([&count] { ++count; })
+                   | fn::filter([] { return true; }, [] { return std::string("no"); })
+                   | fn::transform([] { return 12; });
+    static_assert(std::same_as<decltype(type{} | q), fn::expected<int, std::string>>);
+    CHECK((type{} | q).value() == 12);
+    CHECK(count == 1);
+    CHECK((type{std::unexpect, "error"} | q).error() == "error");
+    CHECK(count == 1);
+  }
+
+  WHEN("intermediate values are not wrapped")
+  {
+    using type = fn::expected<Counted, std::string>;
+    constexpr auto id = [](Counted &&v) { return std::move(v); };
+    auto const q = fn::transform(id) | fn::transform(id) | fn::transform(id) | fn::transform(id);
+    Counted::moves = 0;
+    CHECK((type{std::in_place, 12} | q).value().value == 12);
+    auto const fused = Counted::moves;
+    Counted::moves = 0;
+    CHECK((type{std::in_place, 12} | fn::transform(id) | fn::transform(id) | fn::transform(id) | fn::transform(id))
+              .value()
+              .value
+          == 12);
+    CHECK(fused < Counted::moves);
+  }
+
+  WHEN("lvalue")
+  {
+    // NOTE As with `filter` applied alone, the value passed to the next stage is a copy
+    type const v{12};
+    CHECK((v | (fn::filter(positive, error) | fn::transform([](int &&i) { return i + 1; }))).value() == 13);
+  }
+
+  WHEN("stage without fusion")
+  {
+    auto const q
+        = fn::and_then(half) | fn::or_else([](std::string const &) -> type { return {0}; }) | fn::transform(inc);
+    CHECK((type{12} | q).value() == 7);
+    CHECK((type{7} | q).value() == 1);
+  }
+}
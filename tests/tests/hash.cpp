@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/choice.hpp"
+#include "functional/hash.hpp"
+#include "functional/pack.hpp"
+#include "functional/sum.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+struct NonComparable final {
+  int v;
+};
+struct NonHashable final {};
+} // anonymous namespace
+
+template <> struct std::hash<NonComparable> {
+  auto operator()(NonComparable const &v) const noexcept -> std::size_t { return std::hash<int>{}(v.v); }
+};
+
+TEST_CASE("sum ordering", "[sum][ordering]")
+{
+  using type = fn::sum_for<double, int, std::string>;
+  static_assert(std::is_same_v<type, fn::sum<double, int, std::string>>);
+  static_assert(std::is_same_v<decltype(std::declval<type>() <=> std::declval<type>()), std::partial_ordering>);
+  static_assert(std::is_same_v<decltype(fn::sum<int>{1} <=> fn::sum<int>{2}), std::strong_ordering>);
+  static_assert(not std::three_way_comparable<fn::sum<NonComparable, int>>);
+
+  WHEN("same alternative")
+  {
+    CHECK(type{1} < type{2});
+    CHECK(type{std::string("abc")} < type{std::string("abd")});
+    CHECK(type{1.5} > type{0.5});
+    CHECK(std::is_eq(type{1} <=> type{1}));
+    CHECK(type{1} <= type{1});
+  }
+
+  WHEN("different alternatives are ordered by index")
+  {
+    CHECK(type{100.0} < type{1});
+    CHECK(type{1} < type{std::string("")});
+    CHECK(type{std::string("")} > type{100.0});
+  }
+
+  WHEN("constexpr")
+  {
+    constexpr fn::sum<bool, int> a{12};
+    constexpr fn::sum<bool, int> b{true};
+    static_assert(b < a);
+    static_assert(a > b);
+    static_assert((a <=> fn::sum<bool, int>{12}) == 0);
+  }
+
+  WHEN("choice")
+  {
+    using choice = fn::choice_for<int, std::string>;
+    static_assert(std::is_same_v<decltype(std::declval<choice>() <=> std::declval<choice>()), std::strong_ordering>);
+    CHECK(choice{1} < choice{2});
+    CHECK(choice{2} < choice{std::string("a")});
+    CHECK(std::is_eq(choice{std::string("a")} <=> choice{std::string("a")}));
+  }
+}
+
+TEST_CASE("pack comparison", "[pack][ordering]")
+{
+  using type = fn::pack<int, std::string>;
+  static_assert(std::is_same_v<decltype(std::declval<type>() <=> std::declval<type>()), std::strong_ordering>);
+  static_assert(not std::equality_comparable<fn::pack<NonComparable>>);
+
+  CHECK(type{1, "a"} == type{1, "a"});
+  CHECK(type{1, "a"} != type{1, "b"});
+  CHECK(type{1, "b"} < type{2, "a"});
+  CHECK(type{1, "a"} < type{1, "b"});
+  CHECK(std::is_eq(type{1, "a"} <=> type{1, "a"}));
+
+  int i = 1;
+  int j = 2;
+  CHECK(fn::pack<int &>{i} < fn::pack<int &>{j});
+  CHECK(fn::pack<int &>{i} == fn::pack<int &>{i});
+
+  constexpr fn::pack<int, double> a{1, 0.5};
+  static_assert(a == fn::pack<int, double>{1, 0.5});
+  static_assert(a < fn::pack<int, double>{1, 1.5});
+  static_assert(fn::pack<>{} == fn::pack<>{});
+}
+
+TEST_CASE("sum hash", "[sum][hash]")
+{
+  using type = fn::sum_for<int, NonComparable, std::string>;
+  std::hash<type> const hash{};
+
+  CHECK(hash(type{12}) == hash(type{12}));
+  CHECK(hash(type{12}) == hash(12));
+  CHECK(hash(type{std::string("abc")}) == hash(std::string("abc")));
+  CHECK(hash(type{NonComparable{12}}) == hash(NonComparable{12}));
+  // NOTE Same payload hash, different alternative
+  CHECK(hash(type{12}) != hash(type{NonComparable{12}}));
+
+  static_assert(std::is_same_v<std::hash<fn::choice<int, std::string>>::is_transparent, void>);
+  CHECK(std::hash<fn::choice<int, std::string>>{}(fn::choice<int, std::string>{12})
+        == std::hash<fn::sum<int, std::string>>{}(fn::sum<int, std::string>{12}));
+
+  static_assert(std::is_default_constructible_v<std::hash<fn::sum<int>>>);
+  static_assert(not std::is_default_constructible_v<std::hash<fn::sum<NonHashable, int>>>);
+
+  using pack = fn::pack<int, std::string>;
+  CHECK(std::hash<pack>{}(pack{1, "a"}) == std::hash<pack>{}(pack{1, "a"}));
+  CHECK(std::hash<pack>{}(pack{1, "a"}) != std::hash<pack>{}(pack{1, "b"}));
+}
+
+TEST_CASE("sum heterogeneous lookup", "[sum][hash][ordering]")
+{
+  using type = fn::sum_for<int, std::string>;
+
+  WHEN("sum_equal_to")
+  {
+    constexpr fn::sum_equal_to eq{};
+    static_assert(eq(fn::sum<bool, int>{12}, 12));
+    static_assert(eq(12, fn::sum<bool, int>{12}));
+    static_assert(not eq(fn::sum<bool, int>{12}, 13));
+    static_assert(not eq(fn::sum<bool, int>{true}, 1));
+    static_assert(eq(fn::sum<bool, int>{12}, fn::sum<int>{12}));
+  }
+
+  WHEN("sum_less")
+  {
+    constexpr fn::sum_less less{};
+    static_assert(less(fn::sum<bool, int>{true}, 0));
+    static_assert(not less(0, fn::sum<bool, int>{true}));
+    static_assert(less(fn::sum<bool, int>{12}, 13));
+    static_assert(less(12, fn::sum<bool, int>{13}));
+    static_assert(not less(fn::sum<bool, int>{12}, 12));
+    static_assert(less(fn::sum<bool, int>{false}, fn::sum<bool, int>{true}));
+  }
+
+  WHEN("unordered_map")
+  {
+    std::unordered_map<type, int, std::hash<type>, fn::sum_equal_to> map;
+    map.emplace(type{12}, 1);
+    map.emplace(type{std::string("abc")}, 2);
+    CHECK(map.find(12)->second == 1);
+    CHECK(map.find(std::string("abc"))->second == 2);
+    CHECK(map.find(13) == map.end());
+    CHECK(map.find(type{12})->second == 1);
+    CHECK(map.contains(std::string("abc")));
+  }
+
+  WHEN("map")
+  {
+    std::map<type, int, fn::sum_less> map;
+    map.emplace(type{std::string("abc")}, 2);
+    map.emplace(type{12}, 1);
+    map.emplace(type{3}, 0);
+    CHECK(map.begin()->first == type{3});
+    CHECK(map.find(12)->second == 1);
+    CHECK(map.find(std::string("abc"))->second == 2);
+    CHECK(map.find(std::string("abd")) == map.end());
+    CHECK(map.lower_bound(4)->second == 1);
+  }
+
+  WHEN("choice")
+  {
+    using choice = fn::choice_for<int, std::string>;
+    std::unordered_map<choice, int, std::hash<choice>, fn::sum_equal_to> map;
+    map.emplace(choice{12}, 1);
+    CHECK(map.find(12)->second == 1);
+    CHECK(map.find(choice{12})->second == 1);
+    CHECK(map.find(std::string("abc")) == map.end());
+  }
+}
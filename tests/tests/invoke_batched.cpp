@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/box.hpp"
+#include "functional/invoke_batched.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+struct Node;
+using Tree = fn::sum_for<int, fn::box<Node>>;
+struct Node final {
+  int value;
+  std::vector<Tree> children;
+};
+} // anonymous namespace
+
+TEST_CASE("invoke_batched", "[sum][invoke_batched]")
+{
+  using type = fn::sum_for<int, double, std::string>;
+  static_assert(std::is_same_v<type, fn::sum<double, int, std::string>>);
+
+  std::vector<type> v;
+  v.emplace_back(1);
+  v.emplace_back(std::string("a"));
+  v.emplace_back(0.5);
+  v.emplace_back(2);
+  v.emplace_back(std::string("b"));
+  v.emplace_back(1.5);
+  v.emplace_back(3);
+
+  WHEN("grouped by alternative in normalized order")
+  {
+    std::string result;
+    fn::invoke_batched(v, fn::overload{[&](int i) { result += std::to_string(i); },
+                                       [&](double d) { result += std::to_string(static_cast<int>(d * 10)); },
+                                       [&](std::string const &s) { result += s; }});
+    CHECK(result == "515123ab");
+  }
+
+  WHEN("typed")
+  {
+    std::vector<std::size_t> sizes;
+    fn::invoke_batched(std::as_const(v), [&]<typename T>(std::in_place_type_t<T>, T const &) {
+      sizes.push_back(sizeof(T));
+    });
+    CHECK(sizes
+          == std::vector<std::size_t>{sizeof(double), sizeof(double), sizeof(int), sizeof(int), sizeof(int),
+                                      sizeof(std::string), sizeof(std::string)});
+  }
+
+  WHEN("mutable span")
+  {
+    fn::invoke_batched(std::span<type>(v), fn::overload{[](int &i) { i *= 10; }, [](double &d) { d += 1; },
+                                                        [](std::string &s) { s += s; }});
+    CHECK(v[0] == type{10});
+    CHECK(v[1] == type{std::string("aa")});
+    CHECK(v[2] == type{1.5});
+    CHECK(v[3] == type{20});
+    CHECK(v[5] == type{2.5});
+    CHECK(v[6] == type{30});
+  }
+
+  WHEN("const span")
+  {
+    int count = 0;
+    fn::invoke_batched(std::span<type const>(v).subspan(1, 3), [&](auto const &) { ++count; });
+    CHECK(count == 3);
+  }
+
+  WHEN("empty")
+  {
+    int count = 0;
+    fn::invoke_batched(std::vector<type>{}, [&](auto const &) { ++count; });
+    CHECK(count == 0);
+  }
+
+  WHEN("box")
+  {
+    static_assert(std::is_same_v<Tree, fn::sum<fn::box<Node>, int>>);
+    std::vector<Tree> t;
+    t.emplace_back(1);
+    t.emplace_back(fn::box<Node>{Node{10, {Tree{2}}}});
+    t.emplace_back(3);
+    t.emplace_back(fn::box<Node>{Node{20, {}}});
+
+    std::vector<int> result;
+    fn::invoke_batched(t, fn::overload{[&](int i) { result.push_back(i); }, [&](Node &n) {
+                         result.push_back(n.value + static_cast<int>(n.children.size()));
+                       }});
+    CHECK(result == std::vector<int>{11, 20, 1, 3});
+
+    std::vector<std::size_t> sizes;
+    fn::invoke_batched(std::as_const(t), [&]<typename T>(std::in_place_type_t<T>, T const &) {
+      sizes.push_back(sizeof(T));
+    });
+    CHECK(sizes == std::vector<std::size_t>{sizeof(Node), sizeof(Node), sizeof(int), sizeof(int)});
+  }
+
+  WHEN("constexpr")
+  {
+    static_assert([] {
+      std::vector<fn::sum_for<int, double>> v;
+      v.emplace_back(1);
+      v.emplace_back(0.5);
+      v.emplace_back(2);
+      double result = 0;
+      fn::invoke_batched(v, [&](auto i) { result = result * 10 + i; });
+      return result;
+    }() == 62);
+  }
+}
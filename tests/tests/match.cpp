@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/box.hpp"
+#include "functional/choice.hpp"
+#include "functional/match.hpp"
+#include "functional/sum.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+struct List;
+using Json = fn::choice_for<double, std::string, fn::box<List>>;
+struct List final {
+  std::vector<Json> items;
+};
+
+template <int I> struct Tag final {};
+} // anonymous namespace
+
+TEST_CASE("match", "[match][sum]")
+{
+  using type = fn::sum_for<bool, double, int, std::string>;
+
+  WHEN("exhaustive arms")
+  {
+    constexpr auto fn = [](type const &s) {
+      return fn::match(
+          s, [](bool) { return 0; }, [](double) { return 1; }, [](int) { return 2; },
+          [](std::string const &) { return 3; });
+    };
+    CHECK(fn(type{true}) == 0);
+    CHECK(fn(type{0.5}) == 1);
+    CHECK(fn(type{12}) == 2);
+    CHECK(fn(type{std::string("abc")}) == 3);
+  }
+
+  WHEN("overload resolution among plain arms")
+  {
+    // NOTE `bool` is matched by `int` arm, since integral promotion is better than conversion to `double`
+    constexpr auto fn = [](type const &s) {
+      return fn::match(
+          s, [](double) { return 1; }, [](int) { return 2; }, [](std::string const &) { return 3; });
+    };
+    CHECK(fn(type{true}) == 2);
+    CHECK(fn(type{0.5}) == 1);
+    CHECK(fn(type{12}) == 2);
+    CHECK(fn(type{std::string("abc")}) == 3);
+  }
+
+  WHEN("fn::on arm takes precedence")
+  {
+    constexpr auto fn = [](type const &s) {
+      return fn::match(
+          s, [](auto const &) { return 0; }, fn::on<int>([](int i) { return i; }),
+          fn::on<int, bool>([](auto) { return -1; }));
+    };
+    CHECK(fn(type{12}) == 12);
+    CHECK(fn(type{true}) == -1);
+    CHECK(fn(type{0.5}) == 0);
+  }
+
+  WHEN("several alternatives and default arm")
+  {
+    constexpr auto fn = [](type const &s) {
+      return fn::match(
+          s, fn::on<int, double>([](auto v) { return static_cast<int>(v * 2); }),
+          fn::otherwise([](auto const &) { return -1; }));
+    };
+    CHECK(fn(type{0.5}) == 1);
+    CHECK(fn(type{12}) == 24);
+    CHECK(fn(type{true}) == -1);
+    CHECK(fn(type{std::string("abc")}) == -1);
+  }
+
+  WHEN("typed arms")
+  {
+    auto const fn = [](type const &s) {
+      return fn::match(
+          s, fn::on<std::string>([](std::string const &v) { return v; }),
+          fn::otherwise([]<typename T>(std::in_place_type_t<T>, T const &) -> std::string {
+            return std::is_same_v<T, bool> ? "bool" : "number";
+          }));
+    };
+    CHECK(fn(type{true}) == "bool");
+    CHECK(fn(type{12}) == "number");
+    CHECK(fn(type{std::string("abc")}) == "abc");
+  }
+
+  WHEN("default arm not used")
+  {
+    CHECK(fn::match(
+              type{12}, fn::on<bool, double, int>([](auto) { return 1; }),
+              fn::on<std::string>([](auto const &) { return 2; }), fn::otherwise([](auto const &) { return 3; }))
+          == 1);
+  }
+
+  WHEN("explicit result type")
+  {
+    auto const r = fn::match<long>(
+        type{12}, [](int i) { return i; }, fn::otherwise([](auto const &) { return 0l; }));
+    static_assert(std::is_same_v<decltype(r), long const>);
+    CHECK(r == 12);
+  }
+
+  WHEN("rvalue")
+  {
+    type s{std::string("abc")};
+    std::string const r = fn::match(
+        std::move(s), [](std::string &&v) { return std::move(v); },
+        fn::otherwise([](auto &&) { return std::string(); }));
+    CHECK(r == "abc");
+    CHECK(s.get_ptr<std::string>()->empty());
+  }
+
+  WHEN("mutable lvalue")
+  {
+    type s{12};
+    fn::match(
+        s, [](int &i) { i += 1; }, fn::otherwise([](auto &) {}));
+    CHECK(s == type{13});
+  }
+
+  WHEN("constexpr")
+  {
+    constexpr fn::sum<bool, int> s{12};
+    static_assert(fn::match(s, fn::on<int>([](int i) { return i; }), fn::otherwise([](auto) { return 0; })) == 12);
+    static_assert(fn::match(fn::sum<bool, int>{true}, [](bool) { return 1; }, [](int) { return 2; }) == 1);
+  }
+
+  WHEN("many alternatives")
+  {
+    using large = fn::sum<Tag<0>, Tag<1>, Tag<2>, Tag<3>, Tag<4>, Tag<5>, Tag<6>, Tag<7>, Tag<8>, Tag<9>>;
+    static_assert(std::is_same_v<large, fn::sum_for<Tag<0>, Tag<1>, Tag<2>, Tag<3>, Tag<4>, Tag<5>, Tag<6>, Tag<7>,
+                                                    Tag<8>, Tag<9>>>);
+    constexpr auto fn = [](large const &s) {
+      return fn::match(
+          s, fn::on<Tag<3>>([](auto) { return 3; }), fn::on<Tag<7>, Tag<8>>([](auto) { return 7; }),
+          fn::otherwise([]<typename T>(std::in_place_type_t<T>, auto) { return -1; }));
+    };
+    static_assert(fn(large{Tag<3>{}}) == 3);
+    static_assert(fn(large{Tag<8>{}}) == 7);
+    static_assert(fn(large{Tag<9>{}}) == -1);
+  }
+}
+
+TEST_CASE("match choice", "[match][choice]")
+{
+  using type = fn::choice_for<int, std::string>;
+  CHECK(fn::match(
+            type{12}, [](int i) { return i; }, [](std::string const &) { return 0; })
+        == 12);
+
+  WHEN("box")
+  {
+    Json const json{fn::box<List>{List{{Json{0.5}, Json{std::string("abc")}}}}};
+    auto const size = [](Json const &j) {
+      return fn::match(
+          j, [](List const &l) { return l.items.size(); }, fn::otherwise([](auto const &) { return 1ul; }));
+    };
+    CHECK(size(json) == 2);
+    CHECK(size(Json{0.5}) == 1);
+  }
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/niche.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace {
+struct alignas(4) Literal final {
+  int value;
+};
+struct alignas(4) Negate final {
+  int operand;
+};
+struct alignas(4) Add final {
+  int lh;
+  int rh;
+};
+struct ToAdd final {
+  operator Add const *() const { return nullptr; }
+};
+
+enum class Color : std::uint8_t { red, green, blue };
+enum class Shape : std::uint8_t { circle, square };
+} // anonymous namespace
+
+template <> struct fn::niche_traits<Color> {
+  using storage_t = std::uint8_t;
+  static constexpr storage_t spare_bits = 0xfc;
+};
+
+template <> struct fn::niche_traits<Shape> {
+  using storage_t = std::uint8_t;
+  static constexpr storage_t spare_bits = 0xfe;
+};
+
+TEST_CASE("niche_traits", "[niche]")
+{
+  static_assert(fn::niche_traits<Add *>::spare_bits == 3);
+  static_assert(fn::niche_traits<std::uint64_t const *>::spare_bits == alignof(std::uint64_t) - 1);
+  static_assert(fn::some_niche<Add *>);
+  static_assert(fn::some_niche<bool>);
+  static_assert(fn::some_niche<Color>);
+  static_assert(not fn::some_niche<int>);
+  static_assert(not fn::some_niche<double>);
+  static_assert(not fn::some_niche<void *>);
+  static_assert(not fn::some_niche<Add>);
+}
+
+TEST_CASE("niche_sum", "[niche][sum]")
+{
+  using type = fn::niche_sum_for<Literal const *, Negate const *, Add const *>;
+  static_assert(std::is_same_v<type::value_type, fn::sum_for<Literal const *, Negate const *, Add const *>>);
+  static_assert(sizeof(type) == sizeof(void *));
+  static_assert(sizeof(type::value_type) == 2 * sizeof(void *));
+  static_assert(std::is_trivially_copyable_v<type>);
+  static_assert(type::_tag_mask == 3);
+
+  Literal const l{2};
+  Negate const n{3};
+  Add const a{4, 5};
+
+  constexpr auto eval = fn::overload{[](Literal const *p) -> int { return p->value; },
+                                     [](Negate const *p) -> int { return -p->operand; },
+                                     [](Add const *p) -> int { return p->lh + p->rh; }};
+
+  WHEN("constructors")
+  {
+    type const s1{&l};
+    CHECK(s1.has_value<Literal const *>());
+    CHECK(not s1.has_value(std::in_place_type<Add const *>));
+    CHECK(s1.get<Literal const *>() == &l);
+    CHECK(s1.index() == fn::detail::type_index<Literal const *, Add const *, Literal const *, Negate const *>);
+
+    type const s2{std::in_place_type<Add const *>, &a};
+    CHECK(s2.has_value<Add const *>());
+    CHECK(s2.get<Add const *>() == &a);
+
+    type const s3{std::in_place_type<Negate const *>, nullptr};
+    CHECK(s3.has_value<Negate const *>());
+    CHECK(s3.get<Negate const *>() == nullptr);
+  }
+
+  WHEN("invoke")
+  {
+    CHECK(type{&l}.invoke(eval) == 2);
+    CHECK(type{&n}.invoke(eval) == -3);
+    type const s{&a};
+    CHECK(s.invoke(eval) == 9);
+    CHECK(s.invoke([]<typename T>(std::in_place_type_t<T>, auto) { return sizeof(std::remove_pointer_t<T>); })
+          == sizeof(Add));
+  }
+
+  WHEN("invoke writes back")
+  {
+    Negate const n2{7};
+    type s{&n};
+    s.invoke(fn::overload{[](Literal const *&) {}, [&](Negate const *&p) { p = &n2; }, [](Add const *&) {}});
+    CHECK(s.has_value<Negate const *>());
+    CHECK(s.get<Negate const *>() == &n2);
+    CHECK(s.invoke(eval) == -7);
+  }
+
+  WHEN("transform")
+  {
+    type const s{&l};
+    auto const r = s.transform(fn::overload{[](Literal const *p) -> int { return p->value; },
+                                            [](Negate const *) -> bool { return true; },
+                                            [](Add const *p) -> int { return p->lh; }});
+    static_assert(std::is_same_v<decltype(r), fn::sum<bool, int> const>);
+    CHECK(r == fn::sum<bool, int>{2});
+  }
+
+  WHEN("noexcept")
+  {
+    type s{&l};
+    static_assert(not noexcept(s.invoke(eval)));
+    static_assert(noexcept(s.invoke([](auto) noexcept { return 0; })));
+    static_assert(not noexcept(std::as_const(s).invoke([](auto) { return 0; })));
+    static_assert(noexcept(s.transform([]<typename T>(std::in_place_type_t<T>, auto) noexcept { return 0; })));
+    static_assert(not noexcept(s.transform([](auto) -> int { throw 1; })));
+    static_assert(noexcept(type{std::in_place_type<Add const *>, &a}));
+    static_assert(not std::is_nothrow_constructible_v<type, std::in_place_type_t<Add const *>, ToAdd>);
+  }
+
+  WHEN("conversion to and from sum")
+  {
+    type::value_type const v{&a};
+    type const s{v};
+    CHECK(s.has_value<Add const *>());
+    CHECK(s.to_sum() == v);
+    CHECK(s == type{&a});
+    CHECK(s != type{&l});
+  }
+}
+
+TEST_CASE("niche_sum constexpr", "[niche][sum]")
+{
+  using type = fn::niche_sum_for<Color, Shape, bool>;
+  static_assert(sizeof(type) == 1);
+  static_assert(type{Color::blue}.has_value<Color>());
+  static_assert(type{Color::blue}.get<Color>() == Color::blue);
+  static_assert(type{Shape::square}.get<Shape>() == Shape::square);
+  static_assert(type{true}.get<bool>());
+  static_assert(not type{false}.get<bool>());
+  static_assert(type{false} != type{Color::red});
+  static_assert(type{Shape::circle}.to_sum() == fn::sum_for<Color, Shape, bool>{Shape::circle});
+  static_assert([] {
+    type s{Color::red};
+    s.invoke(fn::overload{[](Color &c) { c = Color::green; }, [](auto &) {}});
+    return s.get<Color>() == Color::green;
+  }());
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/open_sum.hpp"
+#include "functional/optional.hpp"
+#include "functional/transform.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+struct Counted final {
+  static int count;
+  int value;
+
+  explicit Counted(int v) noexcept : value(v) { ++count; }
+  Counted(Counted const &other) noexcept : value(other.value) { ++count; }
+  Counted(Counted &&other) noexcept : value(std::exchange(other.value, 0)) { ++count; }
+  ~Counted() noexcept { --count; }
+};
+int Counted::count = 0;
+
+struct Incomparable final {
+  int value;
+};
+} // anonymous namespace
+
+TEST_CASE("open_sum", "[open_sum]")
+{
+  using type = fn::open_sum<>;
+  static_assert(type::size == 4 * sizeof(void *));
+  static_assert(type::can_hold<int>);
+  static_assert(type::can_hold<std::string>);
+  static_assert(type::can_hold<std::array<char, type::size>>);
+  static_assert(not type::can_hold<std::array<char, type::size + 1>>);
+  static_assert(not type::can_hold<int const>);
+  static_assert(not type::can_hold<std::unique_ptr<int>>); // not copyable
+  static_assert(not type::can_hold<type>);
+  static_assert(fn::some_open_sum<type>);
+  static_assert(fn::some_open_sum<fn::open_sum<8> const &>);
+  static_assert(std::is_nothrow_move_constructible_v<type>);
+  static_assert(std::is_constructible_v<type, int>);
+  static_assert(not std::is_constructible_v<type, std::array<char, type::size + 1>>);
+
+  WHEN("access")
+  {
+    type s{12};
+    CHECK(s.has_value<int>());
+    CHECK(not s.has_value<long>());
+    CHECK(*s.get_ptr<int>() == 12);
+    CHECK(s.get_ptr<long>() == nullptr);
+    *s.get_ptr<int>() += 1;
+    CHECK(s == type{13});
+    CHECK(s != type{13l});
+
+    s.emplace<std::string>(3, 'a');
+    CHECK(s == type{std::string("aaa")});
+    CHECK(s.get_ptr<int>() == nullptr);
+    CHECK(std::as_const(s).get_ptr<std::string>()->size() == 3);
+  }
+
+  WHEN("copy and move")
+  {
+    REQUIRE(Counted::count == 0);
+    {
+      type a{std::in_place_type<Counted>, 12};
+      type b = a;
+      CHECK(Counted::count == 2);
+      CHECK(b.get_ptr<Counted>()->value == 12);
+      type c = std::move(a);
+      CHECK(Counted::count == 3);
+      CHECK(a.get_ptr<Counted>()->value == 0);
+      CHECK(c.get_ptr<Counted>()->value == 12);
+      c = type{0.5};
+      CHECK(Counted::count == 2);
+      c = b;
+      CHECK(Counted::count == 3);
+      a = type{std::string("abc")};
+      b = std::move(a);
+      CHECK(Counted::count == 1);
+      CHECK(b == type{std::string("abc")});
+    }
+    CHECK(Counted::count == 0);
+  }
+
+  WHEN("equality")
+  {
+    CHECK(type{12} == type{12});
+    CHECK(type{12} != type{13});
+    CHECK(type{12} != type{12l});
+    CHECK(type{std::string("abc")} == type{std::string("abc")});
+    CHECK(type{Incomparable{12}} != type{Incomparable{12}});
+  }
+
+  WHEN("hash")
+  {
+    type const a{std::string("abc")};
+    CHECK(a.hashable());
+    CHECK(std::hash<type>{}(a) == std::hash<std::string>{}("abc"));
+    CHECK(not type{Incomparable{12}}.hashable());
+
+    std::unordered_set<type> set;
+    set.insert(type{12});
+    set.insert(type{std::string("abc")});
+    set.insert(type{12});
+    CHECK(set.size() == 2);
+    CHECK(set.contains(type{std::string("abc")}));
+    CHECK(not set.contains(type{12u}));
+  }
+
+  WHEN("invoke")
+  {
+    constexpr auto fn = fn::overload{[](int i) { return i; }, [](std::string const &s) { return static_cast<int>(s.size()); },
+                                     [](fn::open_sum<> const &) { return -1; }};
+    CHECK(type{12}.invoke<int, std::string>(fn) == 12);
+    CHECK(type{std::string("abc")}.invoke<int, std::string>(fn) == 3);
+    CHECK(type{0.5}.invoke<int, std::string>(fn) == -1);
+    CHECK(type{std::string("abcd")}.invoke<int, std::string>(fn) == 4);
+    CHECK(type{12}.invoke<std::string, int>(fn) == 12);
+
+    type s{std::string("abc")};
+    CHECK(s.invoke<std::string>(fn::overload{[]<typename T>(std::in_place_type_t<T>, T &) { return true; },
+                                             [](type &) { return false; }}));
+    std::string const r = std::move(s).invoke<std::string>(
+        fn::overload{[](std::string &&v) { return std::move(v); }, [](type &&) { return std::string(); }});
+    CHECK(r == "abc");
+    CHECK(s.get_ptr<std::string>()->empty());
+  }
+
+  WHEN("type of a value from another shared library")
+  {
+    // NOTE Simulates a copy of the vtable, as found in another shared library which does not export it
+    using fn::detail::_open_sum_vtable_for;
+    fn::detail::_open_sum_vtable const copy = _open_sum_vtable_for<std::string>;
+    static_assert(_open_sum_vtable_for<int>.key == fn::detail::_fnv1a("int"));
+    static_assert(_open_sum_vtable_for<int>.key != _open_sum_vtable_for<unsigned>.key);
+#if __cpp_rtti
+    CHECK(fn::detail::_open_sum_same_type(&copy, &_open_sum_vtable_for<std::string>));
+#else
+    CHECK(not fn::detail::_open_sum_same_type(&copy, &_open_sum_vtable_for<std::string>));
+#endif
+    CHECK(not fn::detail::_open_sum_same_type(&copy, &_open_sum_vtable_for<int>));
+    CHECK(fn::detail::_open_sum_same_type(&_open_sum_vtable_for<int>, &_open_sum_vtable_for<int>));
+  }
+
+  WHEN("pipeline")
+  {
+    type const s{12};
+    CHECK((s.as<int>() | fn::transform([](int i) { return i + 1; })).value() == 13);
+    CHECK(not(s.as<std::string>() | fn::transform([](std::string const &v) { return v.size(); })).has_value());
+    fn::optional<type> const o{type{std::string("abc")}};
+    CHECK((o | fn::and_then([](type const &v) { return v.as<std::string>(); })).value() == "abc");
+  }
+}
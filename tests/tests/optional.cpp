@@ -8,8 +8,33 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <string>
+#include <type_traits>
 #include <utility>
 
+namespace {
+struct ThrowingCopy final {
+  int value;
+
+  constexpr explicit ThrowingCopy(int v) noexcept : value(v) {}
+  ThrowingCopy(ThrowingCopy const &other) noexcept(false) : value(other.value) {}
+  ThrowingCopy(ThrowingCopy &&other) noexcept = default;
+};
+
+// NOTE Counts copies and moves, to check that operator& does not move values into a new pack at every step
+struct Counted final {
+  static int copies;
+  static int moves;
+  int value;
+
+  constexpr explicit Counted(int v) noexcept : value(v) {}
+  Counted(Counted const &other) noexcept : value(other.value) { ++copies; }
+  Counted(Counted &&other) noexcept : value(other.value) { ++moves; }
+};
+int Counted::copies = 0;
+int Counted::moves = 0;
+} // namespace
+
 TEST_CASE("optional pack support", "[optional][pack][and_then][transform][operator_and]")
 {
   WHEN("and_then")
@@ -123,8 +148,9 @@ TEST_CASE("optional pack support", "[optional][pack][and_then][transform][operat
   {
     WHEN("value & value yield pack")
     {
-      static_assert(std::same_as<decltype(std::declval<fn::optional<int>>() & std::declval<fn::optional<double>>()),
-                                 fn::optional<fn::pack<int, double>>>);
+      static_assert(
+          std::same_as<decltype(std::declval<fn::optional<int>>() & std::declval<fn::optional<double>>())::type,
+                       fn::optional<fn::pack<int, double>>>);
 
       CHECK((fn::optional<double>{0.5} //
              & fn::optional<int>{12})
@@ -144,7 +170,7 @@ TEST_CASE("optional pack support", "[optional][pack][and_then][transform][operat
     WHEN("pack & value yield pack")
     {
       static_assert(std::same_as<decltype(std::declval<fn::optional<fn::pack<double, bool>>>()
-                                          & std::declval<fn::optional<int>>()),
+                                          & std::declval<fn::optional<int>>())::type,
                                  fn::optional<fn::pack<double, bool, int>>>);
 
       CHECK((fn::optional<fn::pack<double, bool>>{std::in_place, fn::pack<double, bool>{0.5, true}} //
@@ -177,6 +203,61 @@ TEST_CASE("optional pack support", "[optional][pack][and_then][transform][operat
                                       fn::optional<fn::pack<double, bool>>{fn::pack<double, bool>{0.5, true}},
                                       fn::optional<fn::pack<double, bool>>{fn::pack<double, bool>{0.5, true}}));
     }
+
+    WHEN("result is kept")
+    {
+      constexpr auto make_a = [] { return fn::optional<std::string>{"abc"}; };
+      constexpr auto make_b = [] { return fn::optional<std::string>{"de"}; };
+      auto r = make_a() & make_b();
+      auto s = r & make_b();
+      CHECK(r.value().invoke([](auto const &a, auto const &b) { return a + b; }) == "abcde");
+      CHECK(s.value().invoke([](auto const &...v) { return (std::string{} + ... + v); }) == "abcdede");
+    }
+
+    WHEN("chain of values")
+    {
+      using counted_t = fn::optional<Counted>;
+      using type = fn::optional<fn::pack<Counted, Counted, Counted, Counted>>;
+      counted_t const a{1};
+      counted_t b{2};
+      counted_t const c{3};
+      Counted::copies = 0;
+      Counted::moves = 0;
+
+      type const r = a & b & c & counted_t{4};
+      CHECK(r.has_value());
+      CHECK(Counted::copies == 3);
+      CHECK(Counted::moves == 1 + 1);
+
+      CHECK((a & b & c & a).transform([](auto const &...v) { return (0 + ... + v.value); }).value() == 7);
+      CHECK(Counted::copies == 3);
+      CHECK(Counted::moves == 2);
+
+      CHECK(not(a & counted_t{std::nullopt} & c).has_value());
+      CHECK(not(a & b & counted_t{std::nullopt}).and_then([](auto &&...) { return fn::optional<int>{0}; }).has_value());
+      CHECK(Counted::copies == 3);
+      CHECK(Counted::moves == 2);
+    }
+
+    WHEN("noexcept")
+    {
+      using type = fn::optional<fn::pack<ThrowingCopy, int>>;
+      static_assert(noexcept(std::declval<fn::optional<int>>() & std::declval<fn::optional<double>>()));
+
+      // NOTE operator& only refers to lvalue operands, their values are copied when the result is consumed
+      using ref_t = decltype(std::declval<fn::optional<ThrowingCopy> const &>() & std::declval<fn::optional<int>>());
+      static_assert(noexcept(std::declval<fn::optional<ThrowingCopy> const &>() & std::declval<fn::optional<int>>()));
+      static_assert(not std::is_nothrow_convertible_v<ref_t, type>);
+      using pack_ref_t
+          = decltype(std::declval<fn::optional<fn::pack<ThrowingCopy>> &>() & std::declval<fn::optional<int>>());
+      static_assert(not std::is_nothrow_convertible_v<pack_ref_t, type>);
+
+      // NOTE ... and rvalue operands are moved into the result, which copies them when it is an lvalue
+      using own_t = decltype(std::declval<fn::optional<ThrowingCopy>>() & std::declval<fn::optional<int>>());
+      static_assert(noexcept(std::declval<fn::optional<ThrowingCopy>>() & std::declval<fn::optional<int>>()));
+      static_assert(std::is_nothrow_convertible_v<own_t, type>);
+      static_assert(not std::is_nothrow_convertible_v<own_t const &, type>);
+    }
   }
 }
 
@@ -3,13 +3,19 @@
 // Distributed under the ISC License. See accompanying file LICENSE.md
 // or copy at https://opensource.org/licenses/ISC
 
+#include "functional/and_then.hpp"
+#include "functional/optional.hpp"
 #include "functional/pack.hpp"
+#include "functional/transform.hpp"
 #include "static_check.hpp"
 
 #include <catch2/catch_all.hpp>
 
+#include <functional>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace {
 struct A final {
@@ -197,3 +203,172 @@ TEST_CASE("constexpr pack", "[pack][constexpr]")
   static_assert(r2 == 3 + 14);
   SUCCEED();
 }
+
+TEST_CASE("pack layout", "[pack][layout]")
+{
+  using fn::pack;
+
+  // NOTE Elements are ordered in memory by alignment, only when this makes the pack smaller
+  static_assert(sizeof(pack<char, double, char, double>) == 3 * sizeof(double));
+  static_assert(sizeof(pack<char, double, char>) == 2 * sizeof(double));
+  static_assert(sizeof(pack<bool, int, bool, int, bool>) == 3 * sizeof(int));
+  static_assert(sizeof(pack<char, int &, char>) == 2 * sizeof(void *));
+  static_assert(sizeof(pack<double, int>) == 2 * sizeof(double));
+  static_assert(std::is_aggregate_v<pack<double, int, char>>);
+
+  // NOTE Elements of empty types take no storage, unless of the same type
+  struct Empty final {};
+  static_assert(std::is_empty_v<pack<Empty>>);
+  static_assert(std::is_empty_v<pack<Empty, std::in_place_t>>);
+  static_assert(sizeof(pack<Empty, int, std::in_place_t>) == sizeof(int));
+  static_assert(sizeof(pack<Empty, Empty>) == 2);
+
+  // NOTE Tail padding of non-empty elements is not reused
+  struct Padded final {
+    int a;
+    char b;
+    constexpr explicit Padded(int i) noexcept : a(i), b(0) {}
+  };
+  static_assert(sizeof(Padded) == 2 * sizeof(int));
+  static_assert(sizeof(pack<Padded, char>) == sizeof(Padded) + alignof(Padded));
+  static_assert(sizeof(pack<char, Padded>) == sizeof(Padded) + alignof(Padded));
+  static_assert(sizeof(pack<Padded, char, Empty>) == sizeof(Padded) + alignof(Padded));
+  static_assert(std::is_aggregate_v<pack<char, double>>);
+  static_assert(not std::is_aggregate_v<pack<char, double, char>>);
+
+  using T = pack<char, double, char, double>;
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(std::is_nothrow_default_constructible_v<T>);
+  static_assert(not std::is_constructible_v<T, char, double, char>);
+
+  // NOTE Like aggregate initialization, the constructor rejects narrowing conversions and explicit constructors
+  static_assert(std::is_constructible_v<pack<char, double, char>, char, float, char>);
+  static_assert(not std::is_constructible_v<pack<char, double, char>, int, double, char>);
+  using V = pack<char, std::vector<int>, char>;
+  static_assert(not std::is_aggregate_v<V>);
+  static_assert(not std::is_constructible_v<V, char, int, char>);
+  static_assert(std::is_nothrow_constructible_v<V, char, std::vector<int>, char>);
+  static_assert(not std::is_nothrow_constructible_v<V, char, std::vector<int> const &, char>);
+  V const w = {'a', std::vector<int>{1, 2}, 'b'};
+  CHECK(w.invoke([](char a, std::vector<int> const &b, char c) { return a + b[0] + b[1] + c; }) == 'a' + 3 + 'b');
+
+  constexpr auto fn = [](char a, double b, char c, double d) { return std::pair{a + c, b + d}; };
+  constexpr T c{'a', 0.5, 'b', 1.5};
+  static_assert(c.invoke(fn) == std::pair{'a' + 'b', 2.0});
+
+  T v{'a', 0.5, 'b', 1.5};
+  CHECK(v.invoke(fn) == std::pair{'a' + 'b', 2.0});
+  CHECK(v == T{'a', 0.5, 'b', 1.5});
+  CHECK(v < T{'a', 0.5, 'c', 0.0});
+
+  WHEN("append")
+  {
+    auto const a = pack<char, double>{'a', 0.5}.append('b');
+    static_assert(std::same_as<decltype(a), pack<char, double, char> const>);
+    CHECK(a.append(1.5) == v);
+    CHECK(a.append(std::in_place_type<double>, 1.5) == v);
+
+    int i = 12;
+    auto b = a.append(i);
+    static_assert(std::same_as<decltype(b), pack<char, double, char, int &>>);
+    CHECK(&b.invoke([](char, double, char, int &r) -> int & { return r; }) == &i);
+  }
+
+  WHEN("references")
+  {
+    double d = 0.5;
+    pack<char, double &, char> r{'a', d, 'b'};
+    static_assert(not std::is_aggregate_v<std::remove_cvref_t<decltype(r)>>);
+    r.invoke([](char, double &d, char) { d += 1.0; });
+    CHECK(d == 1.5);
+  }
+}
+
+TEST_CASE("pack views", "[pack][select]")
+{
+  using fn::pack;
+
+  struct Immovable final {
+    int value = 0;
+    constexpr explicit Immovable(int i) noexcept : value(i) {}
+    Immovable(Immovable const &) = delete;
+    Immovable &operator=(Immovable const &) = delete;
+  };
+
+  int i = 3;
+  using T = pack<Immovable, int const, int &, double, Immovable const>;
+  T v{Immovable{1}, 2, i, 0.5, Immovable{5}};
+
+  WHEN("select")
+  {
+    auto s = v.select<4, 0, 2>();
+    static_assert(std::same_as<decltype(s), pack<Immovable const &, Immovable &, int &>>);
+    CHECK(s.invoke([&](Immovable const &a, Immovable &b, int &c) {
+      return &a == &v.project<Immovable const>().invoke(std::identity{}) && b.value == 1 && &c == &i;
+    }));
+    s.invoke([](auto &&, Immovable &b, int &c) {
+      b.value += 10;
+      c += 10;
+    });
+    CHECK(v.invoke([](Immovable const &a, auto &&...) { return a.value; }) == 11);
+    CHECK(i == 13);
+
+    static_assert(std::same_as<decltype(std::as_const(v).select<0, 1>()), pack<Immovable const &, int const &>>);
+    static_assert(std::same_as<decltype(std::as_const(v).select<2>()), pack<int const &>>);
+    static_assert(std::same_as<decltype(v.select<1, 1>()), pack<int const &, int const &>>);
+  }
+
+  WHEN("slice")
+  {
+    static_assert(std::same_as<decltype(v.slice<1, 4>()), pack<int const &, int &, double &>>);
+    static_assert(std::same_as<decltype(v.slice<0, 5>()),
+                                pack<Immovable &, int const &, int &, double &, Immovable const &>>);
+    CHECK(v.slice<1, 4>().invoke([](int a, int b, double c) { return a + b + c; }) == 2 + 3 + 0.5);
+  }
+
+  WHEN("project")
+  {
+    static_assert(std::same_as<decltype(v.project<double, int &>()), pack<double &, int &>>);
+    CHECK(&v.project<double>().invoke(std::identity{}) == &v.select<3>().invoke(std::identity{}));
+  }
+
+  WHEN("rvalue")
+  {
+    using U = pack<std::string, int &, double>;
+    static_assert(std::same_as<decltype(U{"abc", i, 0.5}.select<2, 0>()), pack<double, std::string>>);
+    static_assert(std::same_as<decltype(U{"abc", i, 0.5}.slice<0, 2>()), pack<std::string, int &>>);
+    U u{"abc", i, 0.5};
+    auto s = std::move(u).project<std::string, int &>();
+    CHECK(s.invoke([&](std::string const &a, int &b) { return a == "abc" && &b == &i; }));
+    CHECK(u.invoke([](std::string const &a, auto &&...) { return a.empty(); }));
+
+    // NOTE An element of an rvalue cannot be moved twice
+    constexpr auto can_select = [](auto &&p) { return requires { FWD(p).template select<0, 0>(); }; };
+    constexpr auto can_project = [](auto &&p) { return requires { FWD(p).template project<double, double>(); }; };
+    static_assert(can_select(u));
+    static_assert(can_select(std::as_const(u)));
+    static_assert(not can_select(std::move(u)));
+    static_assert(not can_select(std::move(std::as_const(u))));
+    static_assert(can_project(u));
+    static_assert(not can_project(std::move(u)));
+    static_assert(std::same_as<decltype(std::move(u).select<0, 2>()), pack<std::string, double>>);
+
+    static_assert(noexcept(std::move(u).select<1, 2>()));
+    static_assert(not noexcept(std::move(std::as_const(u)).select<0>())); // NOTE Copy of std::string
+    static_assert(noexcept(std::as_const(u).select<0>()));
+  }
+
+  WHEN("pipeline")
+  {
+    // NOTE Elements of the view are passed to the functions downstream by reference
+    pack<std::string, int, double> p{"abc", 12, 0.5};
+    auto const r = fn::optional{p.select<2, 0>()}
+                   | fn::and_then([&p](double &d, std::string &s) -> fn::optional<std::string *> {
+                       if (&d != &p.project<double>().invoke(std::identity{}))
+                         return {std::nullopt};
+                       return {&s};
+                     })
+                   | fn::transform([](std::string *s) { return s->size(); });
+    CHECK(r.value() == 3);
+  }
+}
@@ -8,7 +8,9 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <array>
 #include <concepts>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -33,8 +35,16 @@ struct NonCopyable final {
   NonCopyable &operator=(NonCopyable const &) = delete;
 };
 
+struct WideIndex final {
+  int v;
+};
+
 } // anonymous namespace
 
+template <> struct fn::sum_index<fn::sum_for<WideIndex, int>> {
+  using type = std::uint32_t;
+};
+
 TEST_CASE("sum basic functionality tests", "[sum]")
 {
   // NOTE This test looks very similar to test in choice.cpp - for good reason.
@@ -52,6 +62,169 @@ TEST_CASE("sum basic functionality tests", "[sum]")
     static_assert(std::same_as<fn::sum_for<int, bool, NonCopyable>, fn::sum<NonCopyable, bool, int>>);
   }
 
+  WHEN("size")
+  {
+    static_assert(std::same_as<sum<int>::index_t, std::uint8_t>);
+    static_assert(std::same_as<sum<bool, int>::index_t, std::uint8_t>);
+    static_assert(sizeof(sum<bool>) == 2);
+    static_assert(sizeof(sum<int>) == 8);
+    static_assert(sizeof(sum<float, int>) == 8);
+    static_assert(sizeof(sum<double, int>) == 16);
+    static_assert(sizeof(sum<bool, char>) == 2);
+    static_assert(sizeof(fn::sum_for<std::array<char, 7>, char>) == 8);
+    static_assert(sizeof(fn::sum_for<std::array<char, 8>, int>) == 12);
+
+    // Discriminator selected by the user
+    static_assert(std::same_as<fn::sum_for<WideIndex, int>::index_t, std::uint32_t>);
+    static_assert(sizeof(fn::sum_for<WideIndex, int>) == 8);
+    static_assert(sizeof(fn::sum_for<WideIndex, int, bool>) == 8); // default, not specialized
+  }
+
+  WHEN("trivial")
+  {
+    using type = sum<double, int>;
+    static_assert(std::is_trivially_copyable_v<type>);
+    static_assert(std::is_trivially_copy_constructible_v<type>);
+    static_assert(std::is_trivially_move_constructible_v<type>);
+    static_assert(std::is_trivially_destructible_v<type>);
+    static_assert(std::is_trivially_copy_assignable_v<type>);
+    static_assert(std::is_trivially_move_assignable_v<type>);
+    static_assert(std::is_trivially_copyable_v<sum<bool>>);
+    static_assert(std::is_trivially_copyable_v<fn::sum_for<bool, char, double, float, int, long, short>>);
+
+    // Some alternatives are not trivial
+    using string_type = fn::sum_for<std::string, int>;
+    static_assert(not std::is_trivially_copyable_v<string_type>);
+    static_assert(not std::is_trivially_copy_constructible_v<string_type>);
+    static_assert(not std::is_trivially_move_constructible_v<string_type>);
+    static_assert(not std::is_trivially_destructible_v<string_type>);
+    static_assert(not std::is_trivially_copy_assignable_v<string_type>);
+    static_assert(not std::is_trivially_move_assignable_v<string_type>);
+    static_assert(std::is_copy_assignable_v<string_type>);
+    static_assert(std::is_move_assignable_v<string_type>);
+    static_assert(std::is_copy_constructible_v<string_type>);
+    static_assert(std::is_move_constructible_v<string_type>);
+    static_assert(not std::is_trivially_destructible_v<sum<TestType, int>>);
+    static_assert(not std::is_copy_constructible_v<sum<NonCopyable, int>>);
+    static_assert(std::is_trivially_destructible_v<sum<NonCopyable, int>>);
+
+    type a{12.5};
+    type b = a;
+    CHECK(b.has_value(std::in_place_type<double>));
+    CHECK(*b.get_ptr(std::in_place_type<double>) == 12.5);
+    type c = std::move(a);
+    CHECK(*c.get_ptr(std::in_place_type<double>) == 12.5);
+
+    std::string const str = "Hello world, this string is long enough to defeat small string optimisation";
+    string_type d{str};
+    string_type e = d;
+    CHECK(*e.get_ptr(std::in_place_type<std::string>) == str);
+    string_type f = std::move(d);
+    CHECK(*f.get_ptr(std::in_place_type<std::string>) == str);
+  }
+
+  WHEN("assignment")
+  {
+    static_assert(not std::is_copy_assignable_v<sum<NonCopyable, int>>);
+    static_assert(not std::is_move_assignable_v<sum<NonCopyable, int>>);
+    static_assert([] {
+      sum<double, int> a{12};
+      sum<double, int> const b{0.5};
+      a = b;
+      return *a.get_ptr(std::in_place_type<double>) == 0.5;
+    }());
+
+    using type = fn::sum_for<std::string, int, std::vector<int>>;
+    std::string const str = "Hello world, this string is long enough to defeat small string optimisation";
+    type a{str};
+    type const b{std::string("Short")};
+    type const c{std::vector<int>{1, 2, 3}};
+    char const *const buffer = a.get_ptr(std::in_place_type<std::string>)->data();
+
+    WHEN("same alternative")
+    {
+      a = b;
+      CHECK(*a.get_ptr(std::in_place_type<std::string>) == "Short");
+      CHECK(a.get_ptr(std::in_place_type<std::string>)->data() == buffer);
+      CHECK(*b.get_ptr(std::in_place_type<std::string>) == "Short");
+
+      a = type{std::string("Other")};
+      CHECK(*a.get_ptr(std::in_place_type<std::string>) == "Other");
+      CHECK(a.get_ptr(std::in_place_type<std::string>)->data() == buffer);
+    }
+
+    WHEN("different alternative")
+    {
+      a = c;
+      CHECK(a.has_value(std::in_place_type<std::vector<int>>));
+      CHECK(*a.get_ptr(std::in_place_type<std::vector<int>>) == std::vector<int>{1, 2, 3});
+      CHECK(c.get_ptr(std::in_place_type<std::vector<int>>)->size() == 3);
+
+      a = type{42};
+      CHECK(a.has_value(std::in_place_type<int>));
+      CHECK(*a.get_ptr(std::in_place_type<int>) == 42);
+
+      a = type{str};
+      CHECK(*a.get_ptr(std::in_place_type<std::string>) == str);
+    }
+
+    WHEN("self assignment")
+    {
+      auto &r = a;
+      a = r;
+      CHECK(*a.get_ptr(std::in_place_type<std::string>) == str);
+    }
+
+    WHEN("destructor called")
+    {
+      TestType::count = 0;
+      {
+        sum<TestType, int> d{std::in_place_type<TestType>};
+        CHECK(TestType::count == 1);
+        d = sum<TestType, int>{12};
+        CHECK(TestType::count == 0);
+        CHECK(*d.get_ptr(std::in_place_type<int>) == 12);
+      }
+      CHECK(TestType::count == 0);
+    }
+  }
+
+  WHEN("emplace")
+  {
+    static_assert([] {
+      sum<double, int> a{12};
+      a.emplace<double>(0.5);
+      return *a.get_ptr(std::in_place_type<double>) == 0.5;
+    }());
+
+    using type = fn::sum_for<std::string, int, std::vector<int>>;
+    type a{12};
+    static_assert(std::same_as<decltype(a.emplace<std::string>("aaa")), std::string &>);
+    std::string &s = a.emplace<std::string>("aaa");
+    CHECK(s == "aaa");
+    CHECK(a.has_value(std::in_place_type<std::string>));
+    CHECK(&s == a.get_ptr(std::in_place_type<std::string>));
+
+    a.emplace<std::vector<int>>(3, 1);
+    CHECK(*a.get_ptr(std::in_place_type<std::vector<int>>) == std::vector<int>{3, 1});
+    CHECK(a == type{std::in_place_type<std::vector<int>>, 3, 1});
+    a.emplace<int>(42);
+    CHECK(*a.get_ptr(std::in_place_type<int>) == 42);
+
+    TestType::count = 0;
+    {
+      sum<TestType, int> d{12};
+      d.emplace<TestType>();
+      CHECK(TestType::count == 1);
+      d.emplace<TestType>();
+      CHECK(TestType::count == 1);
+      d.emplace<int>(3);
+      CHECK(TestType::count == 0);
+      d.emplace<TestType>();
+    }
+    CHECK(TestType::count == 0);
+  }
+
   WHEN("invocable")
   {
     using type = sum<TestType, int>;
@@ -321,6 +494,21 @@ TEST_CASE("sum basic functionality tests", "[sum]")
         return not requires { a != 0.5; }; // no implicit conversion
       }(a));
     }
+
+    WHEN("many alternatives")
+    {
+      using lh_type = fn::sum_for<bool, char, double, float, int, long>;
+      using rh_type = fn::sum_for<double, int, long, short, unsigned>;
+      static_assert(lh_type::size * rh_type::size > fn::detail::_invoke_table_threshold);
+      static_assert(lh_type{42} == rh_type{42});
+      static_assert(lh_type{42} != rh_type{41});
+      static_assert(lh_type{42} != rh_type{42l});
+      static_assert(lh_type{0.5} == rh_type{0.5});
+      static_assert(lh_type{true} != rh_type{1});
+      static_assert(rh_type{short{3}} != lh_type{3});
+      CHECK(lh_type{42l} == rh_type{42l});
+      CHECK(rh_type{42u} != lh_type{42});
+    }
   }
 
   WHEN("invoke_r")
@@ -1053,3 +1053,80 @@ TEST_CASE("sum functions", "[sum][invoke]")
     }
   }
 }
+
+TEST_CASE("sum invoke_with", "[sum][invoke][invoke_with]")
+{
+  using namespace fn;
+
+  using type1 = sum<double, int>;
+  using type2 = sum_for<bool, int, std::string>;
+  type1 a{42};
+  type2 b{std::string("hello")};
+
+  WHEN("value only")
+  {
+    constexpr auto fn = overload{[](auto const &, auto const &) -> int { return 0; },
+                                 [](int i, std::string const &s) -> int { return i + (int)s.size(); }};
+    static_assert(std::same_as<decltype(a.invoke_with(fn, b)), int>);
+    CHECK(a.invoke_with(fn, b) == 47);
+    CHECK(b.invoke_with(fn, a) == 0);
+    CHECK(a.invoke_with(fn, type2{true}) == 0);
+    CHECK(type1{0.5}.invoke_with(fn, b) == 0);
+    CHECK(fn::invoke(fn, a, b) == 47);
+  }
+
+  WHEN("tag and value")
+  {
+    constexpr auto fn = []<typename T, typename U>(std::in_place_type_t<T>, std::in_place_type_t<U>, auto const &,
+                                                   auto const &) -> std::size_t { return sizeof(T) * 100 + sizeof(U); };
+    CHECK(a.invoke_with(fn, b) == 400 + sizeof(std::string));
+    CHECK(a.invoke_with(fn, type2{true}) == 401);
+    CHECK(type1{0.5}.invoke_with(fn, type2{12}) == 804);
+  }
+
+  WHEN("value categories")
+  {
+    constexpr auto fn = overload{[](auto &&, auto &&) -> int { return 0; }, //
+                                 [](int &, std::string &) -> int { return 1; },
+                                 [](int const &, std::string &) -> int { return 2; },
+                                 [](int &&, std::string const &) -> int { return 3; },
+                                 [](int const &&, std::string &&) -> int { return 4; }};
+    CHECK(a.invoke_with(fn, b) == 1);
+    CHECK(std::as_const(a).invoke_with(fn, b) == 2);
+    CHECK(std::move(a).invoke_with(fn, std::as_const(b)) == 3);
+    CHECK(std::move(std::as_const(a)).invoke_with(fn, std::move(b)) == 4);
+  }
+
+  WHEN("mutable")
+  {
+    a.invoke_with(overload{[](auto &, auto &) {}, [](int &i, std::string &s) { s.append(std::to_string(i)); }}, b);
+    CHECK(*b.get_ptr(std::in_place_type<std::string>) == "hello42");
+  }
+
+  WHEN("every combination")
+  {
+    using type3 = sum<bool, double, int>;
+    constexpr auto fn = []<typename T, typename U, typename V>(std::in_place_type_t<T>, std::in_place_type_t<U>,
+                                                               std::in_place_type_t<V>, auto, auto, auto) -> int {
+      return (int)detail::type_index<T, double, int> * 100
+             + (int)detail::type_index<U, bool, int, std::string> * 10 + (int)detail::type_index<V, bool, double, int>;
+    };
+    for (int i = 0; i < 2; ++i) {
+      type1 const x = i == 0 ? type1{0.5} : type1{1};
+      for (int j = 0; j < 2; ++j) {
+        type2 const y = j == 0 ? type2{false} : type2{1};
+        for (int k = 0; k < 3; ++k) {
+          type3 const z = k == 0 ? type3{true} : k == 1 ? type3{0.5} : type3{1};
+          CHECK(x.invoke_with(fn, y, z) == i * 100 + j * 10 + k);
+        }
+      }
+    }
+  }
+
+  WHEN("constexpr")
+  {
+    constexpr auto fn = [](auto i, auto j) -> int { return (int)(i * 10 + j); };
+    static_assert(type1{4}.invoke_with(fn, sum<bool, int>{2}) == 42);
+    static_assert(type1{0.5}.invoke_with(fn, sum<bool, int>{true}) == 6);
+  }
+}
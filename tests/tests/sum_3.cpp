@@ -9,6 +9,7 @@
 #include <catch2/catch_all.hpp>
 
 #include <concepts>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -57,6 +58,42 @@ struct CopyOnly final {
   constexpr CopyOnly &operator=(CopyOnly &&s) = delete;
 };
 
+struct NothrowMove final {
+  static int copies;
+  static int moves;
+  int v;
+
+  constexpr NothrowMove(int i) noexcept : v(i) {}
+  NothrowMove(NothrowMove const &s) : v(s.v) { ++copies; }
+  NothrowMove(NothrowMove &&s) noexcept : v(s.v) { ++moves; }
+  NothrowMove &operator=(NothrowMove const &) = default;
+  NothrowMove &operator=(NothrowMove &&) noexcept = default;
+};
+int NothrowMove::copies = 0;
+int NothrowMove::moves = 0;
+
+struct ThrowingMove final {
+  static int copies;
+  static int moves;
+  int v;
+
+  constexpr ThrowingMove(int i) noexcept : v(i) {}
+  ThrowingMove(ThrowingMove const &s) : v(s.v) { ++copies; }
+  ThrowingMove(ThrowingMove &&s) : v(s.v) { ++moves; }
+  ThrowingMove &operator=(ThrowingMove const &) = default;
+  ThrowingMove &operator=(ThrowingMove &&) = default;
+};
+int ThrowingMove::copies = 0;
+int ThrowingMove::moves = 0;
+
+struct ThrowingCtor final {
+  explicit ThrowingCtor(int i)
+  {
+    if (i < 0)
+      throw std::runtime_error("negative");
+  }
+};
+
 } // anonymous namespace
 
 TEST_CASE("sum move and copy", "[sum][has_value][get_ptr]")
@@ -274,6 +311,46 @@ TEST_CASE("sum move and copy", "[sum][has_value][get_ptr]")
       }(std::move(std::as_const(a))));
     }
   }
+
+  WHEN("conversion from subset")
+  {
+    WHEN("trivially copyable types")
+    {
+      using T = sum<bool, double, int, long>;
+      sum<double, long> const a{12L};
+      T const b{a};
+      CHECK(b.index == 3);
+      CHECK(b == T{12L});
+      CHECK(T{sum<double, long>{0.5}} == T{0.5});
+      CHECK(T{std::in_place_type<sum<int>>, sum<int>{42}} == T{42});
+
+      constexpr T c{sum<double, long>{12L}};
+      static_assert(c.index == 3);
+      static_assert(c == T{12L});
+      static_assert(T{sum<bool, int>{true}} == T{true});
+    }
+
+    WHEN("non-trivial types")
+    {
+      using T = fn::sum_for<double, int, std::string>;
+      fn::sum_for<int, std::string> a{std::string("baz")};
+      T const b{a};
+      CHECK(b == T{std::string("baz")});
+      T const c{std::move(a)};
+      CHECK(c == T{std::string("baz")});
+      CHECK(T{fn::sum_for<int, std::string>{12}} == T{12});
+    }
+
+    WHEN("move only type")
+    {
+      using T = sum<MoveOnly, double, int>;
+      sum<MoveOnly, int> a{std::in_place_type<MoveOnly>, 12};
+      T const b{std::move(a)};
+      CHECK(a.invoke([](auto &&i) { return static_cast<int>(i); }) == -1);
+      CHECK(b.index == 0);
+      CHECK(b.invoke([](auto &&i) { return static_cast<int>(i); }) == 12);
+    }
+  }
 }
 
 TEST_CASE("sum", "[sum][has_value][get_ptr]")
@@ -779,3 +856,87 @@ TEST_CASE("sum", "[sum][has_value][get_ptr]")
     }
   }
 }
+
+TEST_CASE("sum exception specification", "[sum][noexcept]")
+{
+  using fn::sum;
+
+  WHEN("special members")
+  {
+    using T = fn::sum_for<int, std::string>;
+    static_assert(std::is_nothrow_move_constructible_v<T>);
+    static_assert(std::is_nothrow_move_assignable_v<T>);
+    static_assert(not std::is_nothrow_copy_constructible_v<T>);
+    static_assert(not std::is_nothrow_copy_assignable_v<T>);
+    static_assert(std::is_nothrow_copy_constructible_v<sum<double, int>>);
+    static_assert(not std::is_nothrow_move_constructible_v<sum<ThrowingMove, int>>);
+    static_assert(std::is_nothrow_constructible_v<sum<int, std::string>, int>);
+    static_assert(not std::is_nothrow_constructible_v<sum<int, std::string>, std::string const &>);
+    static_assert(std::is_nothrow_constructible_v<sum<double, int, std::string>, T &&>);
+    static_assert(not std::is_nothrow_constructible_v<sum<double, int, std::string>, T const &>);
+  }
+
+  WHEN("vector reallocation moves when it is safe")
+  {
+    NothrowMove::copies = 0;
+    NothrowMove::moves = 0;
+    std::vector<sum<NothrowMove, int>> v;
+    for (int i = 0; i < 100; ++i)
+      v.emplace_back(std::in_place_type<NothrowMove>, i);
+    CHECK(NothrowMove::copies == 0);
+    CHECK(NothrowMove::moves > 0);
+    CHECK(v.back().get_ptr<NothrowMove>()->v == 99);
+  }
+
+  WHEN("vector reallocation copies when move may throw")
+  {
+    ThrowingMove::copies = 0;
+    ThrowingMove::moves = 0;
+    std::vector<sum<ThrowingMove, int>> v;
+    for (int i = 0; i < 100; ++i)
+      v.emplace_back(std::in_place_type<ThrowingMove>, i);
+    CHECK(ThrowingMove::copies > 0);
+    CHECK(ThrowingMove::moves == 0);
+    CHECK(v.back().get_ptr<ThrowingMove>()->v == 99);
+  }
+
+  WHEN("emplace leaves the old value if construction throws")
+  {
+    sum<ThrowingCtor, std::string> s{std::string("abc")};
+    static_assert(not noexcept(s.emplace<ThrowingCtor>(1)));
+    static_assert(noexcept(s.emplace<std::string>()));
+    CHECK_THROWS_AS(s.emplace<ThrowingCtor>(-1), std::runtime_error);
+    CHECK(s.has_value<std::string>());
+    CHECK(*s.get_ptr<std::string>() == "abc");
+    s.emplace<ThrowingCtor>(1);
+    CHECK(s.has_value<ThrowingCtor>());
+  }
+
+  WHEN("invoke and transform")
+  {
+    sum<double, int> s{12};
+    constexpr auto nothrow = [](auto i) noexcept -> int { return static_cast<int>(i); };
+    constexpr auto throwing = [](auto i) -> int {
+      if (i > 0)
+        throw std::runtime_error("positive");
+      return static_cast<int>(i);
+    };
+    constexpr auto partial = fn::overload{[](int) noexcept -> int { return 0; }, [](double) -> int { return 1; }};
+    static_assert(noexcept(s.invoke(nothrow)));
+    static_assert(not noexcept(s.invoke(throwing)));
+    static_assert(not noexcept(s.invoke(partial)));
+    static_assert(noexcept(std::as_const(s).invoke_r<long>(nothrow)));
+    static_assert(not noexcept(std::move(s).invoke_r<long>(throwing)));
+    static_assert(noexcept(s.transform(nothrow)));
+    static_assert(not noexcept(s.transform(throwing)));
+    static_assert(not noexcept(s.transform([](auto) noexcept { return ThrowingMove{1}; }))); // NOTE Move may throw
+    static_assert(noexcept(fn::invoke(nothrow, s)));
+    static_assert(not noexcept(fn::invoke(throwing, s)));
+    static_assert(noexcept(s.invoke_with([](auto, auto) noexcept {}, s)));
+    static_assert(not noexcept(s.invoke_with([](auto, auto) {}, s)));
+
+    CHECK_THROWS_AS(s.invoke(throwing), std::runtime_error);
+    CHECK_THROWS_AS(s.transform(throwing), std::runtime_error);
+    CHECK(sum<double, int>{-1}.invoke(throwing) == -1);
+  }
+}
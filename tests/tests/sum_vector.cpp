@@ -0,0 +1,276 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/sum_vector.hpp"
+#include "functional/sum.hpp"
+#include "functional/utility.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <concepts>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct TestType final {
+  static int count;
+  TestType() noexcept { ++count; }
+  TestType(TestType const &) noexcept { ++count; }
+  ~TestType() noexcept { --count; }
+};
+int TestType::count = 0;
+
+struct Throwing final {
+  int value;
+
+  explicit Throwing(int v) : value(v)
+  {
+    if (v < 0)
+      throw v;
+  }
+};
+
+} // anonymous namespace
+
+TEST_CASE("sum_vector", "[sum_vector]")
+{
+  using fn::sum;
+  using fn::sum_vector;
+
+  static_assert(std::same_as<fn::sum_vector_for<int, double>, sum_vector<double, int>>);
+  static_assert(std::same_as<fn::sum_vector_for<int, std::string, bool>::value_type,
+                             fn::sum_for<int, std::string, bool>>);
+  static_assert(std::same_as<sum_vector<double, int>::index_t, sum<double, int>::index_t>);
+  static_assert(sum_vector<double, int>::has_type<int>);
+  static_assert(not sum_vector<double, int>::has_type<bool>);
+
+  using type = fn::sum_vector_for<int, double, std::string>;
+  type v;
+  CHECK(v.empty());
+  CHECK(v.size() == 0);
+
+  v.push_back(type::value_type{12});
+  v.push_back(type::value_type{std::string("hello")});
+  v.emplace_back<int>(42);
+  v.push_back(type::value_type{0.5});
+  type::value_type const s{3};
+  v.push_back(s);
+  CHECK(v.size() == 5);
+  CHECK(not v.empty());
+
+  WHEN("discriminators")
+  {
+    constexpr auto int_index = fn::detail::type_index<int, double, int, std::string>;
+    static_assert(std::same_as<fn::sum_vector_for<int, double, std::string>, sum_vector<double, int, std::string>>);
+    CHECK(v.index.size() == 5);
+    CHECK(v.index[0] == int_index);
+    CHECK(v.index[2] == int_index);
+    CHECK(v.offset[0] == 0);
+    CHECK(v.offset[1] == 0);
+    CHECK(v.offset[2] == 1);
+    CHECK(v.offset[3] == 0);
+    CHECK(v.offset[4] == 2);
+  }
+
+  WHEN("span")
+  {
+    static_assert(std::same_as<decltype(v.get_span<int>()), std::span<int>>);
+    static_assert(std::same_as<decltype(std::as_const(v).get_span<int>()), std::span<int const>>);
+    CHECK(v.get_span<int>().size() == 3);
+    CHECK(v.get_span(std::in_place_type<int>)[0] == 12);
+    CHECK(v.get_span(std::in_place_type<int>)[1] == 42);
+    CHECK(v.get_span(std::in_place_type<int>)[2] == 3);
+    CHECK(v.get_span<double>().size() == 1);
+    CHECK(v.get_span<std::string>().size() == 1);
+    CHECK(std::as_const(v).get_span<std::string>()[0] == "hello");
+
+    for (auto &i : v.get_span<int>())
+      i += 1;
+    CHECK(*v.get_ptr<int>(2) == 43);
+  }
+
+  WHEN("get_ptr")
+  {
+    CHECK(v.has_value<int>(0));
+    CHECK(not v.has_value<int>(1));
+    CHECK(v.has_value(1, std::in_place_type<std::string>));
+    CHECK(*v.get_ptr<int>(0) == 12);
+    CHECK(v.get_ptr<double>(0) == nullptr);
+    CHECK(*std::as_const(v).get_ptr(1, std::in_place_type<std::string>) == "hello");
+    CHECK(*v.get_ptr<double>(3) == 0.5);
+    CHECK(*v.get_ptr<int>(4) == 3);
+  }
+
+  WHEN("invoke")
+  {
+    constexpr auto fn = fn::overload{[](int &i) -> int { return i; }, [](int const &) -> int { return -1; },
+                                     [](double d) -> int { return (int)(d * 10); },
+                                     [](std::string const &s) -> int { return (int)s.size(); }};
+    static_assert(std::same_as<decltype(v.invoke(0, fn)), int>);
+    CHECK(v.invoke(0, fn) == 12);
+    CHECK(v.invoke(1, fn) == 5);
+    CHECK(v.invoke(2, fn) == 42);
+    CHECK(v.invoke(3, fn) == 5);
+    CHECK(std::as_const(v).invoke(4, fn) == -1);
+
+    constexpr auto fn2 = []<typename T>(std::in_place_type_t<T>, auto const &) -> std::size_t { return sizeof(T); };
+    CHECK(v.invoke(1, fn2) == sizeof(std::string));
+    CHECK(std::as_const(v).invoke(3, fn2) == sizeof(double));
+
+    v.invoke(1, [](auto &v) {
+      if constexpr (std::same_as<decltype(v), std::string &>)
+        v = "world";
+    });
+    CHECK(*v.get_ptr<std::string>(1) == "world");
+  }
+
+  WHEN("transform")
+  {
+    auto const r = v.transform(1, fn::overload{[](int i) -> int { return i; }, [](double d) -> double { return d; },
+                                               [](std::string const &s) -> bool { return s.empty(); }});
+    static_assert(std::same_as<decltype(r), fn::sum_for<bool, double, int> const>);
+    CHECK(r == fn::sum_for<bool, double, int>{false});
+    CHECK(std::as_const(v).transform(3, [](auto const &v) { return v; }) == type::value_type{0.5});
+    CHECK(v.transform(4, []<typename T>(std::in_place_type_t<T>, auto const &v) { return v; })
+          == type::value_type{3});
+  }
+
+  WHEN("pop_back and clear")
+  {
+    v.pop_back();
+    CHECK(v.size() == 4);
+    CHECK(v.get_span<int>().size() == 2);
+    v.pop_back();
+    CHECK(v.get_span<double>().size() == 0);
+    v.clear();
+    CHECK(v.empty());
+    CHECK(v.get_span<int>().empty());
+    CHECK(v.get_span<std::string>().empty());
+  }
+
+  WHEN("destructor called")
+  {
+    TestType::count = 0;
+    {
+      sum_vector<TestType, int> w;
+      w.emplace_back<TestType>();
+      w.emplace_back<int>(1);
+      w.push_back(sum<TestType, int>{std::in_place_type<TestType>});
+      CHECK(TestType::count == 2);
+      w.pop_back();
+      CHECK(TestType::count == 1);
+    }
+    CHECK(TestType::count == 0);
+  }
+
+  WHEN("reserve")
+  {
+    v.reserve(10);
+    v.reserve(8, std::in_place_type<std::string>);
+    CHECK(v.index.capacity() >= 10);
+    CHECK(std::get<2>(v.data).capacity() >= 8);
+    CHECK(v.size() == 5);
+  }
+
+  WHEN("emplace_back throws")
+  {
+    sum_vector<Throwing, int> w;
+    w.emplace_back<int>(1);
+    w.emplace_back<Throwing>(2);
+    CHECK_THROWS_AS(w.emplace_back<Throwing>(-1), int);
+    CHECK(w.size() == 2);
+    CHECK(w.offset.size() == 2);
+    CHECK(w.get_span<Throwing>().size() == 1);
+    w.emplace_back<Throwing>(3);
+    CHECK(w.get_ptr<Throwing>(2)->value == 3);
+    CHECK(w.offset[2] == 1);
+  }
+
+  WHEN("bool alternative")
+  {
+    using type = fn::sum_vector_for<int, bool>;
+    type w;
+    bool &b = w.emplace_back<bool>(true);
+    CHECK(b);
+    w.push_back(type::value_type{12});
+    w.push_back(type::value_type{false});
+    type::value_type const t{true};
+    w.push_back(t);
+    REQUIRE(w.size() == 4);
+    static_assert(std::same_as<decltype(w.get_span<bool>()), std::span<bool>>);
+    static_assert(std::same_as<decltype(std::as_const(w).get_span<bool>()), std::span<bool const>>);
+    CHECK(w.get_span<bool>().size() == 3);
+    w.get_span<bool>()[1] = true;
+    CHECK(*w.get_ptr<bool>(2));
+    CHECK(w.get_ptr<bool>(1) == nullptr);
+    CHECK(w.invoke(3, [](auto v) { return static_cast<int>(v); }) == 1);
+
+    type const u = w;
+    w.pop_back();
+    CHECK(w.get_span<bool>().size() == 2);
+    CHECK(u.get_span<bool>().size() == 3);
+    CHECK(*u.get_ptr<bool>(3));
+    w = u;
+    CHECK(w.size() == 4);
+    w.clear();
+    CHECK(w.get_span<bool>().empty());
+
+    static_assert([] {
+      fn::sum_vector_for<int, bool> v;
+      for (int i = 0; i < 5; ++i)
+        v.emplace_back<bool>(i % 2 == 0);
+      auto const w = v;
+      return w.get_span<bool>().size() + w.get_span<bool>()[4];
+    }() == 6);
+  }
+
+  WHEN("many alternatives")
+  {
+    using many = fn::sum_vector_for<bool, char, signed char, unsigned char, short, unsigned short, int, unsigned, long,
+                                    unsigned long, long long, unsigned long long, float, double, long double,
+                                    char16_t, char32_t, std::string>;
+    static_assert(many::value_type::size > fn::detail::_invoke_table_threshold);
+    many w;
+    w.emplace_back<long double>(1.5);
+    w.emplace_back<std::string>("abc");
+    w.emplace_back<char32_t>(U'x');
+    w.emplace_back<bool>(true);
+    constexpr auto fn = fn::overload{[](std::string const &s) -> int { return (int)s.size(); },
+                                     [](auto const &v) -> int { return (int)(v * 2); }};
+    CHECK(w.invoke(0, fn) == 3);
+    CHECK(w.invoke(1, fn) == 3);
+    CHECK(std::as_const(w).invoke(2, fn) == 2 * (int)U'x');
+    CHECK(w.invoke(3, fn) == 2);
+    CHECK(w.invoke(1, []<typename T>(std::in_place_type_t<T>, auto const &) { return sizeof(T); })
+          == sizeof(std::string));
+    w.pop_back();
+    CHECK(w.size() == 3);
+    CHECK(w.get_span<bool>().empty());
+  }
+
+  WHEN("noexcept")
+  {
+    static_assert(noexcept(v.invoke(0, [](auto const &) noexcept { return 0; })));
+    static_assert(not noexcept(v.invoke(0, [](auto const &) { return 0; })));
+    static_assert(noexcept(std::as_const(v).transform(0, [](auto const &) noexcept { return 0; })));
+    static_assert(not noexcept(v.transform(0, []<typename T>(std::in_place_type_t<T>, auto const &) { return 0; })));
+  }
+
+  WHEN("constexpr")
+  {
+    static_assert([] {
+      fn::sum_vector_for<int, double> v;
+      v.emplace_back<int>(1);
+      v.push_back(fn::sum_for<int, double>{0.5});
+      v.emplace_back<int>(2);
+      return v.invoke(2, [](auto i) -> double { return i; }) + v.get_span<int>().size()
+             + v.invoke(1, [](auto i) -> double { return i; });
+    }() == 4.5);
+  }
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2024 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "functional/and_then.hpp"
+#include "functional/expected.hpp"
+#include "functional/filter.hpp"
+#include "functional/inspect.hpp"
+#include "functional/optional.hpp"
+#include "functional/transform.hpp"
+#include "functional/views.hpp"
+
+#include <catch2/catch_all.hpp>
+
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+using type = fn::expected<int, std::string>;
+
+auto make_data() -> std::vector<type>
+{
+  return {type{12}, type{std::unexpect, "a"}, type{7}, type{-2}, type{std::unexpect, "b"}, type{0}};
+}
+
+template <typename T> auto to_vector(auto &&r) -> std::vector<T>
+{
+  std::vector<T> result;
+  for (auto &&v : FWD(r))
+    result.emplace_back(FWD(v));
+  return result;
+}
+
+constexpr auto half = [](int i) -> type {
+  if (i % 2 != 0)
+    return std::unexpected<std::string>("odd");
+  return {i / 2};
+};
+constexpr auto inc = [](int i) { return i + 1; };
+constexpr auto positive = [](int i) { return i > 0; };
+constexpr auto error = [](int i) { return std::to_string(i); };
+constexpr auto size = [](std::string const &e) { return static_cast<int>(e.size()) * 100; };
+} // anonymous namespace
+
+TEST_CASE("views", "[views][and_then][filter][inspect][recover][transform]")
+{
+  auto const data = make_data();
+
+  WHEN("recover")
+  {
+    auto const v = data | fn::views::recover(size);
+    CHECK(to_vector<int>(v | std::views::transform([](type const &r) { return r.value(); }))
+          == std::vector<int>{12, 100, 7, -2, 100, 0});
+  }
+
+  WHEN("functors applied to each element")
+  {
+    auto const v = data | fn::views::and_then(half) | fn::views::transform(inc) | fn::views::filter(positive, error);
+    static_assert(std::ranges::random_access_range<decltype(v)>);
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(v)>, type>);
+    REQUIRE(std::ranges::size(v) == data.size());
+    CHECK(v[0].value() == 7);
+    CHECK(v[1].error() == "a");
+    CHECK(v[2].error() == "odd");
+    CHECK(v[3].error() == "0");
+    CHECK(v[4].error() == "b");
+    CHECK(v[5].value() == 1);
+  }
+
+  WHEN("lazy")
+  {
+    int count = 0;
+    auto v = data | fn::views::inspect([&count](int) { ++count; });
+    CHECK(count == 0);
+    auto const first = *std::ranges::begin(v);
+    CHECK(first.value() == 12);
+    CHECK(count == 1);
+    int values = 0;
+    for (auto const &r : v | std::views::take(3))
+      values += r.has_value() ? 1 : 0;
+    CHECK(values == 2);
+    CHECK(count == 3); // NOTE Not called for errors
+  }
+
+  WHEN("lvalue element")
+  {
+    // NOTE `inspect` returns the element as is, so the view refers to the range rather than copying it
+    auto v = data | fn::views::inspect([](int) {});
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(v)>, type const &>);
+    CHECK(&*std::ranges::begin(v) == &data[0]);
+    auto w = data | std::views::transform([](type const &r) { return r; }) | fn::views::inspect([](int) {});
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(w)>, type>);
+  }
+
+  WHEN("functions are copied")
+  {
+    auto v = [&] {
+      int const offset = 10;
+      auto const add = [offset](int i) { return i + offset; };
+      return data | fn::views::transform(add);
+    }();
+    CHECK((*std::ranges::begin(v)).value() == 22);
+  }
+
+  WHEN("pipeline")
+  {
+    auto const p = fn::and_then(half) | fn::transform(inc) | fn::filter(positive, error);
+    auto const v = data | fn::views::apply(p);
+    auto const w = data | fn::views::and_then(half) | fn::views::transform(inc) | fn::views::filter(positive, error);
+    REQUIRE(std::ranges::size(v) == std::ranges::size(w));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      CHECK(v[i].has_value() == w[i].has_value());
+      CHECK((v[i].has_value() ? v[i].value() == w[i].value() : v[i].error() == w[i].error()));
+    }
+    CHECK(to_vector<int>(data | fn::views::apply(fn::transform(inc)) | fn::views::values)
+          == std::vector<int>{13, 8, -1, 1});
+  }
+
+  WHEN("optional")
+  {
+    std::vector<fn::optional<int>> const o{fn::optional<int>{3}, fn::optional<int>{}, fn::optional<int>{-1}};
+    constexpr auto non_negative = [](int i) { return i >= 0 ? fn::optional<int>{i} : fn::optional<int>{}; };
+    CHECK(to_vector<int>(o | fn::views::and_then(non_negative) | fn::views::transform(inc) | fn::views::values)
+          == std::vector<int>{4});
+  }
+}
+
+TEST_CASE("views values and errors", "[views][values][errors]")
+{
+  auto data = make_data();
+
+  WHEN("lvalue elements")
+  {
+    auto v = data | fn::views::values;
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(v)>, int &>);
+    CHECK(to_vector<int>(v) == std::vector<int>{12, 7, -2, 0});
+    CHECK(&*std::ranges::begin(v) == &data[0].value());
+    for (int &i : v)
+      i += 1;
+    CHECK(data[2].value() == 8);
+
+    auto e = std::as_const(data) | fn::views::errors;
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(e)>, std::string const &>);
+    CHECK(to_vector<std::string>(e) == std::vector<std::string>{"a", "b"});
+    CHECK(&*std::ranges::begin(e) == &data[1].error());
+  }
+
+  WHEN("prvalue elements")
+  {
+    int count = 0;
+    auto const source = data | std::views::transform([&count](type const &r) {
+                          ++count;
+                          return r;
+                        });
+    auto v = source | fn::views::values;
+    static_assert(std::same_as<std::ranges::range_reference_t<decltype(v)>, int &>);
+    CHECK(to_vector<int>(v) == std::vector<int>{12, 7, -2, 0});
+    CHECK(count == 6); // NOTE Each element evaluated once
+
+    count = 0;
+    CHECK(to_vector<std::string>(source | fn::views::errors) == std::vector<std::string>{"a", "b"});
+    CHECK(count == 6);
+  }
+
+  WHEN("compose with standard views")
+  {
+    CHECK(to_vector<int>(data | fn::views::transform(inc) | fn::views::values | std::views::take(2))
+          == std::vector<int>{13, 8});
+    CHECK(to_vector<int>(data | std::views::reverse | fn::views::values
+                         | std::views::filter([](int i) { return i > 0; }))
+          == std::vector<int>{7, 12});
+    CHECK(to_vector<std::string>(data | std::views::take(2) | fn::views::errors) == std::vector<std::string>{"a"});
+    CHECK(std::ranges::distance(data | fn::views::values) + std::ranges::distance(data | fn::views::errors)
+          == std::ranges::ssize(data));
+  }
+
+  WHEN("move-only values")
+  {
+    std::vector<fn::expected<std::unique_ptr<int>, int>> u;
+    u.emplace_back(std::make_unique<int>(12));
+    u.emplace_back(std::unexpect, 1);
+    std::vector<std::unique_ptr<int>> moved;
+    for (auto &p : u | std::views::transform([](auto &v) noexcept { return std::move(v); }) | fn::views::values)
+      moved.push_back(std::move(p));
+    REQUIRE(moved.size() == 1);
+    CHECK(*moved[0] == 12);
+    CHECK(u[0].value() == nullptr);
+  }
+}